@@ -0,0 +1,427 @@
+#include "raster/Arc.hpp"
+#include "raster/Backend.hpp"
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Line.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Kernel = void (*)(const raster::Surface& surface, int radius, std::uint32_t color);
+
+	struct BenchCase
+	{
+		const char* kernel;
+		const char* mode;
+		Kernel run;
+
+		// Cases above the CPU's level are skipped, since CircleNaive would quietly time its fallback under their name.
+		raster::SimdLevel simd_level = raster::SimdLevel::scalar;
+	};
+
+	struct Options
+	{
+		int min_radius = 1;
+		int max_radius = 4096;
+		int warmup = 2;
+		int repetitions = 10;
+		double min_sample_ms = 2.0;
+		bool json = false;
+		std::string filter;
+
+		// Names of two backends to diff at every radius instead of running the sweep.
+		std::string cross_check_a;
+		std::string cross_check_b;
+	};
+
+	struct Summary
+	{
+		double min;
+		double median;
+		double mean;
+		double stddev;
+		double p95;
+	};
+
+	// The kernels only store a packed 32-bit colour, so its value does not affect their cost.
+	const std::uint32_t bench_color = raster::PackARGB(0x12, 0x34, 0x56);
+
+	const BenchCase cases[] = {
+		{ "naive", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleNaive(s, r, c); } },
+		{ "naive_scalar", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleNaive(s, r, c, raster::SimdLevel::scalar); } },
+		{ "naive_sse2", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleNaive(s, r, c, raster::SimdLevel::sse2); }, raster::SimdLevel::sse2 },
+		{ "naive_avx2", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleNaive(s, r, c, raster::SimdLevel::avx2); }, raster::SimdLevel::avx2 },
+		{ "naive_avx512", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleNaive(s, r, c, raster::SimdLevel::avx512); }, raster::SimdLevel::avx512 },
+		{ "bresenham", "outline", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleBresenham(s, r, false, c); } },
+		{ "bresenham", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleBresenham(s, r, true, c); } },
+		{ "wu", "outline", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleWu(s, r, false, c); } },
+		{ "wu", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleWu(s, r, true, c); } },
+		{ "ring", "quarter", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleRing(s, r, r - (r + 3) / 4, c); } },
+		{ "span_fill", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::CircleSpanFill(s, r, c); } },
+		// Three-quarter gauge, the reflex case that can need two spans per row.
+		{ "arc", "outline", [](const raster::Surface& s, int r, std::uint32_t c) { raster::DrawArc(s, 0, 0, r, raster::MakeArcRange(-45.0, 270.0), false, c); } },
+		{ "arc", "filled", [](const raster::Surface& s, int r, std::uint32_t c) { raster::DrawArc(s, 0, 0, r, raster::MakeArcRange(-45.0, 270.0), true, c); } },
+		// Blits of span lists generated once per radius, which is what a cached span form costs per draw.
+		{ "spans", "outline", [](const raster::Surface& s, int r, std::uint32_t c)
+			{
+				thread_local raster::SpanList spans = { 0, 0, {} };
+
+				if (spans.width != 2 * r)
+				{
+					spans = raster::CircleSpansBresenham(r, false);
+				}
+
+				raster::DrawSpans(s, 0, 0, spans, c);
+			} },
+		{ "spans", "filled", [](const raster::Surface& s, int r, std::uint32_t c)
+			{
+				thread_local raster::SpanList spans = { 0, 0, {} };
+
+				if (spans.width != 2 * r)
+				{
+					spans = raster::CircleSpansBresenham(r, true);
+				}
+
+				raster::DrawSpans(s, 0, 0, spans, c);
+			} },
+		// One full-width EFLA chord per row of the bounding box.
+		{ "chord_efla", "rows", [](const raster::Surface& s, int r, std::uint32_t c)
+			{
+				for (int y = 0; y < 2 * r; ++y)
+				{
+					raster::ChordEFLA(s, 0, y, 2 * r, y, c);
+				}
+			} },
+		{ "line", "rows", [](const raster::Surface& s, int r, std::uint32_t c)
+			{
+				for (int y = 0; y < 2 * r; ++y)
+				{
+					raster::DrawLine(s, 0, y, 2 * r - 1, y, c);
+				}
+			} },
+		// Lines from the centre to every pixel on the left and top edges, extended to twice their length so
+		// that half of every line is clipped away.
+		{ "line", "fan", [](const raster::Surface& s, int r, std::uint32_t c)
+			{
+				for (int i = 0; i < 2 * r; ++i)
+				{
+					raster::DrawLine(s, r, r, -r, 2 * i - r, c);
+					raster::DrawLine(s, r, r, 2 * i - r, -r, c);
+				}
+			} },
+	};
+
+	void PrintUsage(const char* program)
+	{
+		std::printf("Usage: %s [--min-radius N] [--max-radius N] [--warmup N] [--repetitions N] [--min-sample-ms MS] [--kernel NAME] [--cross-check A,B] [--csv | --json]\n", program);
+		std::printf("Backends:");
+
+		for (const raster::CircleBackend& backend : raster::GetCircleBackends())
+		{
+			std::printf(" %s", backend.name);
+		}
+
+		std::printf("\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+			const bool has_value = i + 1 < argc;
+
+			if (std::strcmp(arg, "--json") == 0)
+			{
+				options.json = true;
+			}
+			else if (std::strcmp(arg, "--csv") == 0)
+			{
+				options.json = false;
+			}
+			else if (std::strcmp(arg, "--min-radius") == 0 && has_value)
+			{
+				options.min_radius = std::max(1, std::atoi(argv[++i]));
+			}
+			else if (std::strcmp(arg, "--max-radius") == 0 && has_value)
+			{
+				options.max_radius = std::atoi(argv[++i]);
+			}
+			else if (std::strcmp(arg, "--warmup") == 0 && has_value)
+			{
+				options.warmup = std::max(0, std::atoi(argv[++i]));
+			}
+			else if (std::strcmp(arg, "--repetitions") == 0 && has_value)
+			{
+				options.repetitions = std::max(1, std::atoi(argv[++i]));
+			}
+			else if (std::strcmp(arg, "--min-sample-ms") == 0 && has_value)
+			{
+				options.min_sample_ms = std::atof(argv[++i]);
+			}
+			else if (std::strcmp(arg, "--kernel") == 0 && has_value)
+			{
+				options.filter = argv[++i];
+			}
+			else if (std::strcmp(arg, "--cross-check") == 0 && has_value)
+			{
+				const std::string pair = argv[++i];
+				const std::size_t comma = pair.find(',');
+
+				if (comma == std::string::npos)
+				{
+					PrintUsage(argv[0]);
+					return false;
+				}
+
+				options.cross_check_a = pair.substr(0, comma);
+				options.cross_check_b = pair.substr(comma + 1);
+			}
+			else
+			{
+				PrintUsage(argv[0]);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	Summary Summarize(std::vector<double> samples)
+	{
+		std::sort(samples.begin(), samples.end());
+
+		const std::size_t n = samples.size();
+		double sum = 0.0;
+
+		for (double sample : samples)
+		{
+			sum += sample;
+		}
+
+		const double mean = sum / n;
+		double variance = 0.0;
+
+		for (double sample : samples)
+		{
+			variance += (sample - mean) * (sample - mean);
+		}
+
+		const double median = n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+		const std::size_t p95_index = std::min(n - 1, static_cast<std::size_t>(std::ceil(0.95 * n)) - 1);
+
+		return { samples.front(), median, mean, n > 1 ? std::sqrt(variance / (n - 1)) : 0.0, samples[p95_index] };
+	}
+
+	std::size_t CountCovered(const raster::Surface& surface)
+	{
+		std::size_t covered = 0;
+
+		for (int y = 0; y < surface.height; ++y)
+		{
+			const std::uint32_t* row = surface.Row(y);
+			covered += static_cast<std::size_t>(std::count_if(row, row + surface.width, [](std::uint32_t pixel) { return pixel != 0; }));
+		}
+
+		return covered;
+	}
+
+	// Returns the time of one kernel call in nanoseconds, averaged over enough calls to fill one sample. Every kernel,
+	// the anti-aliased one included, stores its pixels without reading the surface, so the calls repaint the same
+	// surface back to back.
+	double TimeSample(const BenchCase& bench_case, const raster::Surface& surface, int radius, std::uint32_t color, int& iterations, double min_sample_ms)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		while (true)
+		{
+			const Clock::time_point start = Clock::now();
+
+			for (int i = 0; i < iterations; ++i)
+			{
+				bench_case.run(surface, radius, color);
+			}
+
+			const double elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			if (elapsed_ns >= min_sample_ms * 1e6 || iterations >= (1 << 24))
+			{
+				return elapsed_ns / iterations;
+			}
+
+			iterations *= 2;
+		}
+	}
+
+	// Diffs two backends at every radius in the range, in every mode both of them draw, and returns the number of
+	// cases whose pixels differ, so a faster kernel can be shown to match a reference before it is used.
+	int RunCrossCheck(const Options& options, const raster::CircleBackend& a, const raster::CircleBackend& b)
+	{
+		constexpr std::uint32_t color = raster::PackARGB(0x12, 0x34, 0x56);
+		const bool modes[] = { false, true };
+		int mismatching_cases = 0;
+		bool first_record = true;
+
+		if (options.json)
+		{
+			std::printf("[\n");
+		}
+		else
+		{
+			std::printf("backend_a,backend_b,mode,radius,mismatches,first_x,first_y,ns_a,ns_b,speedup\n");
+		}
+
+		for (int radius = options.min_radius; radius <= options.max_radius; ++radius)
+		{
+			for (const bool filled : modes)
+			{
+				if (!filled && (!a.outline || !b.outline))
+				{
+					continue;
+				}
+
+				const raster::CrossCheckResult result = raster::CrossCheck(a, b, radius, filled, color, options.min_sample_ms);
+				const double speedup = result.ns_b > 0.0 ? result.ns_a / result.ns_b : 0.0;
+				const char* mode = filled ? "filled" : "outline";
+
+				if (options.json)
+				{
+					std::printf("%s  {\"backend_a\": \"%s\", \"backend_b\": \"%s\", \"mode\": \"%s\", \"radius\": %d, \"mismatches\": %zu, "
+						"\"first_x\": %d, \"first_y\": %d, \"ns_a\": %.1f, \"ns_b\": %.1f, \"speedup\": %.3f}",
+						first_record ? "" : ",\n", a.name, b.name, mode, radius, result.mismatches, result.first_x, result.first_y, result.ns_a, result.ns_b, speedup);
+				}
+				else
+				{
+					std::printf("%s,%s,%s,%d,%zu,%d,%d,%.1f,%.1f,%.3f\n",
+						a.name, b.name, mode, radius, result.mismatches, result.first_x, result.first_y, result.ns_a, result.ns_b, speedup);
+				}
+
+				first_record = false;
+				mismatching_cases += result.mismatches != 0;
+				std::fflush(stdout);
+			}
+		}
+
+		if (options.json)
+		{
+			std::printf("\n]\n");
+		}
+
+		std::fprintf(stderr, "%s vs %s: %d mismatching cases\n", a.name, b.name, mismatching_cases);
+		return mismatching_cases;
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	Options options;
+
+	if (!ParseOptions(argc, argv, options))
+	{
+		return 1;
+	}
+
+	if (!options.cross_check_a.empty())
+	{
+		const raster::CircleBackend* a = raster::FindCircleBackend(options.cross_check_a);
+		const raster::CircleBackend* b = raster::FindCircleBackend(options.cross_check_b);
+
+		if (a == nullptr || b == nullptr)
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+
+		return RunCrossCheck(options, *a, *b) == 0 ? 0 : 2;
+	}
+
+	std::vector<std::uint32_t> pixels;
+	bool first_record = true;
+
+	if (options.json)
+	{
+		std::printf("[\n");
+	}
+	else
+	{
+		std::printf("kernel,mode,radius,iterations,ns_min,ns_median,ns_mean,ns_stddev,ns_p95,pixels,bytes,pixels_per_s\n");
+	}
+
+	const raster::SimdLevel simd_level = raster::DetectSimdLevel();
+
+	for (int radius = options.min_radius; radius <= options.max_radius; radius *= 2)
+	{
+		const int size = 2 * radius;
+		pixels.assign(static_cast<std::size_t>(size) * size, 0);
+		const raster::Surface surface = { pixels.data(), size, size, size };
+
+		for (const BenchCase& bench_case : cases)
+		{
+			if ((!options.filter.empty() && options.filter != bench_case.kernel) || bench_case.simd_level > simd_level)
+			{
+				continue;
+			}
+
+			raster::Clear(surface, 0);
+			bench_case.run(surface, radius, bench_color);
+			const std::size_t covered = CountCovered(surface);
+
+			// Every kernel writes packed 32-bit ARGB, the only pixel format in raster::Surface, so the bytes written
+			// per call are the covered pixels times four and there is no format to sweep.
+			const std::size_t bytes = covered * sizeof(std::uint32_t);
+
+			int iterations = 1;
+
+			for (int i = 0; i < options.warmup; ++i)
+			{
+				TimeSample(bench_case, surface, radius, bench_color, iterations, options.min_sample_ms);
+			}
+
+			std::vector<double> samples;
+
+			for (int i = 0; i < options.repetitions; ++i)
+			{
+				samples.push_back(TimeSample(bench_case, surface, radius, bench_color, iterations, options.min_sample_ms));
+			}
+
+			const Summary ns = Summarize(samples);
+			const double pixels_per_s = ns.median > 0.0 ? covered / (ns.median * 1e-9) : 0.0;
+
+			if (options.json)
+			{
+				std::printf("%s  {\"kernel\": \"%s\", \"mode\": \"%s\", \"radius\": %d, \"iterations\": %d, "
+					"\"ns\": {\"min\": %.1f, \"median\": %.1f, \"mean\": %.1f, \"stddev\": %.1f, \"p95\": %.1f}, "
+					"\"pixels\": %zu, \"bytes\": %zu, \"pixels_per_s\": %.0f}",
+					first_record ? "" : ",\n", bench_case.kernel, bench_case.mode, radius, iterations,
+					ns.min, ns.median, ns.mean, ns.stddev, ns.p95, covered, bytes, pixels_per_s);
+			}
+			else
+			{
+				std::printf("%s,%s,%d,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%zu,%zu,%.0f\n",
+					bench_case.kernel, bench_case.mode, radius, iterations,
+					ns.min, ns.median, ns.mean, ns.stddev, ns.p95, covered, bytes, pixels_per_s);
+			}
+
+			first_record = false;
+			std::fflush(stdout);
+		}
+	}
+
+	if (options.json)
+	{
+		std::printf("\n]\n");
+	}
+
+	return 0;
+}
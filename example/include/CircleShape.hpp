@@ -0,0 +1,57 @@
+#ifndef CIRCLE_SHAPE_HPP
+#define CIRCLE_SHAPE_HPP
+
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+
+// A circle that the example composites in software; it has no texture of its own, since every frame is drawn into
+// the damaged regions of the game's framebuffer texture.
+class CircleShape
+{
+private:
+	SDL_Point center_;
+	int radius_;
+	SDL_Rect bbox_;
+	SDL_Color color_;
+	bool filled_;
+
+public:
+	CircleShape(const SDL_Point& center, int radius, const SDL_Color& color, bool filled = false) : 
+	center_(center), 
+	radius_(radius), 
+	color_(color), 
+	filled_(filled)
+    {
+        bbox_.x = center_.x - radius_;
+        bbox_.y = center_.y - radius_;
+        bbox_.w = 2 * radius_;
+        bbox_.h = 2 * radius_;
+    }
+
+    void MoveTo(const SDL_Point& new_center)
+    {
+        center_ = new_center;
+        bbox_.x = center_.x - radius_;
+        bbox_.y = center_.y - radius_;
+    }
+
+    const SDL_Rect& GetBoundingBox() const
+    {
+        return bbox_;
+    }
+
+    // Rasterizes the circle into a region of a larger framebuffer whose top-left pixel is (origin_x, origin_y) on
+    // screen, clipped to the region.
+    void Draw(const raster::Surface& region, int origin_x, int origin_y) const
+    {
+        const std::uint32_t color = raster::PackARGB(color_.r, color_.g, color_.b);
+        raster::DrawCircleBresenham(region, bbox_.x - origin_x, bbox_.y - origin_y, radius_, filled_, color);
+    }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef DAMAGE_TRACKER_HPP
+#define DAMAGE_TRACKER_HPP
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+// Screen regions that changed since the last present. Rects are clipped to the screen and overlapping or touching
+// rects are merged into their union, so every damaged pixel is redrawn and uploaded exactly once.
+class DamageTracker
+{
+private:
+    SDL_Rect bounds_;
+    std::vector<SDL_Rect> rects_;
+
+    static bool Touches(const SDL_Rect& a, const SDL_Rect& b)
+    {
+        return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+    }
+
+public:
+    explicit DamageTracker(const SDL_Rect& bounds) : bounds_(bounds)
+    {
+    }
+
+    void Add(const SDL_Rect& rect)
+    {
+        SDL_Rect merged;
+
+        if (!SDL_IntersectRect(&rect, &bounds_, &merged))
+        {
+            return;
+        }
+
+        // Absorbing one rect can make the union touch another, so keep merging until nothing touches.
+        bool absorbed = true;
+
+        while (absorbed)
+        {
+            absorbed = false;
+
+            for (auto it = rects_.begin(); it != rects_.end(); ++it)
+            {
+                if (Touches(*it, merged))
+                {
+                    SDL_UnionRect(&*it, &merged, &merged);
+                    rects_.erase(it);
+                    absorbed = true;
+                    break;
+                }
+            }
+        }
+
+        rects_.push_back(merged);
+    }
+
+    // Marks a moved object's old and new bounding boxes.
+    void AddMove(const SDL_Rect& from, const SDL_Rect& to)
+    {
+        Add(from);
+        Add(to);
+    }
+
+    void AddAll()
+    {
+        rects_.assign(1, bounds_);
+    }
+
+    const std::vector<SDL_Rect>& GetRects() const
+    {
+        return rects_;
+    }
+
+    bool IsEmpty() const
+    {
+        return rects_.empty();
+    }
+
+    int GetArea() const
+    {
+        int area = 0;
+
+        for (const SDL_Rect& rect : rects_)
+        {
+            area += rect.w * rect.h;
+        }
+
+        return area;
+    }
+
+    void Clear()
+    {
+        rects_.clear();
+    }
+};
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
-#include "CircleTexture.hpp"
+#include "CircleShape.hpp"
+#include "DamageTracker.hpp"
+#include "raster/Surface.hpp"
 
 #include <SDL2/SDL.h>
 
@@ -14,11 +16,16 @@ private:
 	bool running_;
 
 	SDL_Point mouse_pos_;
-	std::unique_ptr<CircleTexture> circle_texture_;
+	std::unique_ptr<CircleShape> circle_;
 
 	SDL_Window* window_;
 	SDL_Renderer* renderer_;
 
+	// The scene is composited in software straight into the locked memory of a streaming texture, and only damaged
+	// regions are locked and redrawn.
+	SDL_Texture* framebuffer_texture_;
+	DamageTracker damage_;
+
 public:
 	Game();
 
@@ -35,6 +42,9 @@ public:
 	void Tick();
 	
 	void Render();
+
+	// Redraws region of the screen into target, which holds exactly that region.
+	void Composite(const raster::Surface& target, const SDL_Rect& region);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,302 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include "Circle.hpp"
+#include "Point.hpp"
+#include "Rect.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Arithmetic of the batch kernels for each supported coordinate type. Squared distances are compared in Distance,
+// which is wide enough for them: int32_t coordinates are widened to int64_t and stay exact. Other types have no
+// specialization and do not compile.
+template <typename T>
+struct BatchTraits;
+
+template <>
+struct BatchTraits<float>
+{
+    using Distance = float;
+};
+
+template <>
+struct BatchTraits<double>
+{
+    using Distance = double;
+};
+
+template <>
+struct BatchTraits<std::int32_t>
+{
+    using Distance = std::int64_t;
+};
+
+// Result of a bulk predicate: element i is bit i % 64 of word i / 64, and the bits past the end of the batch are
+// zero.
+using BatchMask = std::vector<std::uint64_t>;
+
+inline bool TestBit(const BatchMask& mask, std::size_t index)
+{
+    return (mask[index / 64] >> (index % 64)) & 1;
+}
+
+inline std::size_t CountBits(const BatchMask& mask)
+{
+    std::size_t count = 0;
+
+    for (std::uint64_t word : mask)
+    {
+        count += static_cast<std::size_t>(__builtin_popcountll(word));
+    }
+
+    return count;
+}
+
+namespace batch_detail
+{
+    // Packs 64 flags of 0 or 1 into a word, eight at a time: the multiply gathers the low bit of every byte into
+    // the top byte, in element order on little-endian targets.
+    inline std::uint64_t Pack(const std::uint8_t* flags)
+    {
+        std::uint64_t word = 0;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            std::uint64_t bytes;
+            std::memcpy(&bytes, flags + 8 * i, sizeof(bytes));
+            word |= ((bytes * 0x0102040810204080ull) >> 56) << (8 * i);
+        }
+
+        return word;
+    }
+
+    // Runs test over every element and writes the mask. Elements go through a byte array a chunk at a time, so the
+    // test loop is a branch-free compare over contiguous arrays that the compiler can vectorize, and packing into
+    // words is a separate pass.
+    template <typename Test>
+    void Evaluate(std::size_t size, BatchMask& mask, Test test)
+    {
+        constexpr std::size_t chunk_size = 1024;
+
+        mask.assign((size + 63) / 64, 0);
+
+        alignas(64) std::uint8_t flags[chunk_size];
+
+        for (std::size_t base = 0; base < size; base += chunk_size)
+        {
+            const std::size_t count = std::min(chunk_size, size - base);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                flags[i] = test(base + i);
+            }
+
+            std::fill(flags + count, flags + (count + 63) / 64 * 64, 0);
+
+            for (std::size_t i = 0; i < count; i += 64)
+            {
+                mask[(base + i) / 64] = Pack(flags + i);
+            }
+        }
+    }
+} // namespace batch_detail
+
+// Structure-of-arrays storage for many points, for predicates over all of them at once.
+template <typename T>
+class PointBatch
+{
+    using Distance = typename BatchTraits<T>::Distance;
+
+public:
+    std::vector<T> x_;
+    std::vector<T> y_;
+
+    void Reserve(std::size_t capacity)
+    {
+        x_.reserve(capacity);
+        y_.reserve(capacity);
+    }
+
+    void Add(const Point<T>& point)
+    {
+        x_.push_back(point.x_);
+        y_.push_back(point.y_);
+    }
+
+    void Clear()
+    {
+        x_.clear();
+        y_.clear();
+    }
+
+    std::size_t GetSize() const
+    {
+        return x_.size();
+    }
+
+    Point<T> Get(std::size_t index) const
+    {
+        return { x_[index], y_[index] };
+    }
+
+    // Which points lie inside circle, as Circle<T>::Contains.
+    void InCircle(const Circle<T>& circle, BatchMask& mask) const
+    {
+        const T* x = x_.data();
+        const T* y = y_.data();
+        const Distance cx = circle.center_.x_;
+        const Distance cy = circle.center_.y_;
+        const Distance radius_squared = static_cast<Distance>(circle.radius_) * circle.radius_;
+
+        batch_detail::Evaluate(GetSize(), mask, [=](std::size_t i) -> std::uint8_t
+            {
+                const Distance dx = x[i] - cx;
+                const Distance dy = y[i] - cy;
+                return dx * dx + dy * dy <= radius_squared;
+            });
+    }
+
+    // Which points lie inside rect, as Rect<T>::Contains.
+    void InRect(const Rect<T>& rect, BatchMask& mask) const
+    {
+        const T* x = x_.data();
+        const T* y = y_.data();
+        const T left = rect.GetTopLeft().x_;
+        const T top = rect.GetTopLeft().y_;
+        const T right = rect.GetBottomRight().x_;
+        const T bottom = rect.GetBottomRight().y_;
+
+        batch_detail::Evaluate(GetSize(), mask, [=](std::size_t i) -> std::uint8_t
+            {
+                return (x[i] >= left) & (y[i] >= top) & (x[i] < right) & (y[i] < bottom);
+            });
+    }
+};
+
+// Structure-of-arrays storage for many circles, for predicates over all of them at once.
+template <typename T>
+class CircleBatch
+{
+    using Distance = typename BatchTraits<T>::Distance;
+
+public:
+    std::vector<T> x_;
+    std::vector<T> y_;
+    std::vector<T> radius_;
+
+    void Reserve(std::size_t capacity)
+    {
+        x_.reserve(capacity);
+        y_.reserve(capacity);
+        radius_.reserve(capacity);
+    }
+
+    void Add(const Circle<T>& circle)
+    {
+        x_.push_back(circle.center_.x_);
+        y_.push_back(circle.center_.y_);
+        radius_.push_back(circle.radius_);
+    }
+
+    void Clear()
+    {
+        x_.clear();
+        y_.clear();
+        radius_.clear();
+    }
+
+    std::size_t GetSize() const
+    {
+        return x_.size();
+    }
+
+    Circle<T> Get(std::size_t index) const
+    {
+        return { x_[index], y_[index], radius_[index] };
+    }
+
+    // Which circles contain point, as Circle<T>::Contains.
+    void Contains(const Point<T>& point, BatchMask& mask) const
+    {
+        const T* x = x_.data();
+        const T* y = y_.data();
+        const T* radius = radius_.data();
+        const Distance px = point.x_;
+        const Distance py = point.y_;
+
+        batch_detail::Evaluate(GetSize(), mask, [=](std::size_t i) -> std::uint8_t
+            {
+                const Distance dx = x[i] - px;
+                const Distance dy = y[i] - py;
+                const Distance r = radius[i];
+                return dx * dx + dy * dy <= r * r;
+            });
+    }
+
+    // Which circles touch rect, as Circle<T>::Intersects: the distance to the nearest point of the closed rect.
+    void Intersects(const Rect<T>& rect, BatchMask& mask) const
+    {
+        const T* x = x_.data();
+        const T* y = y_.data();
+        const T* radius = radius_.data();
+        const Distance left = rect.GetTopLeft().x_;
+        const Distance top = rect.GetTopLeft().y_;
+        const Distance right = rect.GetBottomRight().x_;
+        const Distance bottom = rect.GetBottomRight().y_;
+
+        batch_detail::Evaluate(GetSize(), mask, [=](std::size_t i) -> std::uint8_t
+            {
+                const Distance cx = x[i];
+                const Distance cy = y[i];
+                const Distance dx = cx - std::min(std::max(cx, left), right);
+                const Distance dy = cy - std::min(std::max(cy, top), bottom);
+                const Distance r = radius[i];
+                return dx * dx + dy * dy <= r * r;
+            });
+    }
+
+    // Which circles overlap circle, as Circle<T>::Intersects.
+    void Intersects(const Circle<T>& circle, BatchMask& mask) const
+    {
+        const T* x = x_.data();
+        const T* y = y_.data();
+        const T* radius = radius_.data();
+        const Distance cx = circle.center_.x_;
+        const Distance cy = circle.center_.y_;
+        const Distance cr = circle.radius_;
+
+        batch_detail::Evaluate(GetSize(), mask, [=](std::size_t i) -> std::uint8_t
+            {
+                const Distance dx = x[i] - cx;
+                const Distance dy = y[i] - cy;
+                const Distance reach = radius[i] + cr;
+                return dx * dx + dy * dy <= reach * reach;
+            });
+    }
+
+    // Whether circle i overlaps circle i of other, for every i below the smaller size; meant for candidate pairs
+    // gathered by a broad phase such as QuadTree into two batches.
+    void IntersectsPairwise(const CircleBatch<T>& other, BatchMask& mask) const
+    {
+        const T* x = x_.data();
+        const T* y = y_.data();
+        const T* radius = radius_.data();
+        const T* other_x = other.x_.data();
+        const T* other_y = other.y_.data();
+        const T* other_radius = other.radius_.data();
+
+        batch_detail::Evaluate(std::min(GetSize(), other.GetSize()), mask, [=](std::size_t i) -> std::uint8_t
+            {
+                const Distance dx = static_cast<Distance>(x[i]) - other_x[i];
+                const Distance dy = static_cast<Distance>(y[i]) - other_y[i];
+                const Distance reach = static_cast<Distance>(radius[i]) + other_radius[i];
+                return dx * dx + dy * dy <= reach * reach;
+            });
+    }
+};
+
+#endif
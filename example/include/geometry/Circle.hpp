@@ -25,7 +25,7 @@ public:
 
     bool Contains(const Point<T>& point) const
     {
-        return center_.GetDistance(point) <= radius_;
+        return center_.GetDistanceSquared(point) <= static_cast<double>(radius_) * radius_;
     }
 
     bool Contains(const Rect<T>& rect) const
@@ -38,7 +38,13 @@ public:
         const T clamped_x = std::clamp(center_.x_, rect.GetTopLeft().x_, rect.GetTopRight().x_);
         const T clamped_y = std::clamp(center_.y_, rect.GetTopLeft().y_, rect.GetBottomLeft().y_);
 
-        return center_.GetDistance({ clamped_x, clamped_y }) <= radius_;
+        return center_.GetDistanceSquared({ clamped_x, clamped_y }) <= static_cast<double>(radius_) * radius_;
+    }
+
+    bool Intersects(const Circle<T>& circle) const
+    {
+        const double reach = static_cast<double>(radius_) + circle.radius_;
+        return center_.GetDistanceSquared(circle.center_) <= reach * reach;
     }
 
     void MoveTo(const Point<T>& destination)
@@ -25,7 +25,16 @@ public:
 
     double GetDistance(const Point<T>& point) const
     {
-        return sqrt(((point.x_ - x_) * (point.x_ - x_)) + ((point.y_ - y_) * (point.y_ - y_)));
+        return sqrt(GetDistanceSquared(point));
+    }
+
+    // Computed in double so that integer coordinates cannot overflow; comparing it against a squared radius avoids
+    // the sqrt of GetDistance.
+    double GetDistanceSquared(const Point<T>& point) const
+    {
+        const double dx = static_cast<double>(point.x_) - x_;
+        const double dy = static_cast<double>(point.y_) - y_;
+        return dx * dx + dy * dy;
     }
 
     friend Point<T> operator+(const Point<T>& lhs, const Point<T>& rhs)
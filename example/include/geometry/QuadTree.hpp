@@ -0,0 +1,361 @@
+#ifndef QUAD_TREE_HPP
+#define QUAD_TREE_HPP
+
+#include "Circle.hpp"
+#include "Point.hpp"
+#include "Rect.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Loose quadtree over Circle<T> or Rect<T>. Every node's loose bounds are its cell grown by half a cell on each
+// side, so a shape is stored in the deepest node whose cell holds its centre and is at least as large as the shape;
+// it never straddles children and a move only relinks one item. Queries descend into nodes whose loose bounds
+// overlap the query and then run the shapes' own Contains/Intersects predicates.
+template <typename T, typename Shape>
+class QuadTree
+{
+    static_assert(std::is_same_v<Shape, Circle<T>> || std::is_same_v<Shape, Rect<T>>);
+
+public:
+    using Id = std::uint32_t;
+
+private:
+    struct Bounds
+    {
+        double min_x;
+        double min_y;
+        double max_x;
+        double max_y;
+
+        bool Overlaps(const Bounds& other) const
+        {
+            return min_x <= other.max_x && other.min_x <= max_x && min_y <= other.max_y && other.min_y <= max_y;
+        }
+    };
+
+    struct Node
+    {
+        double center_x;
+        double center_y;
+        double half_size;
+        int depth;
+        std::array<std::unique_ptr<Node>, 4> children;
+        std::vector<Id> items;
+    };
+
+    struct Record
+    {
+        Shape shape;
+        Node* node;
+        std::uint32_t slot;
+    };
+
+    // Held through a pointer so that moving the tree keeps Record::node and the &root checks valid.
+    std::unique_ptr<Node> root_;
+    int max_depth_;
+    std::vector<Record> records_;
+    std::vector<Id> free_ids_;
+    std::size_t size_;
+
+    static Bounds GetBounds(const Circle<T>& circle)
+    {
+        const double x = circle.center_.x_;
+        const double y = circle.center_.y_;
+        const double r = circle.radius_;
+        return { x - r, y - r, x + r, y + r };
+    }
+
+    static Bounds GetBounds(const Rect<T>& rect)
+    {
+        const double x = rect.top_left_.x_;
+        const double y = rect.top_left_.y_;
+        return { x, y, x + rect.width_, y + rect.height_ };
+    }
+
+    static Bounds GetLooseBounds(const Node& node)
+    {
+        const double extent = 2.0 * node.half_size;
+        return { node.center_x - extent, node.center_y - extent, node.center_x + extent, node.center_y + extent };
+    }
+
+    // Deepest node whose cell holds the shape's centre and is at least as large as the shape. Shapes centred
+    // outside the root, or larger than it, stay in the root, which every query visits.
+    Node* FindNode(const Bounds& bounds)
+    {
+        const double center_x = (bounds.min_x + bounds.max_x) / 2.0;
+        const double center_y = (bounds.min_y + bounds.max_y) / 2.0;
+        const double extent = std::max(bounds.max_x - bounds.min_x, bounds.max_y - bounds.min_y);
+        Node* node = root_.get();
+
+        if (std::abs(center_x - root_->center_x) > root_->half_size || std::abs(center_y - root_->center_y) > root_->half_size)
+        {
+            return node;
+        }
+
+        while (node->depth < max_depth_ && node->half_size >= extent)
+        {
+            const int quadrant = (center_x >= node->center_x ? 1 : 0) | (center_y >= node->center_y ? 2 : 0);
+            std::unique_ptr<Node>& child = node->children[quadrant];
+
+            if (!child)
+            {
+                const double half = node->half_size / 2.0;
+                child = std::make_unique<Node>();
+                child->center_x = node->center_x + ((quadrant & 1) ? half : -half);
+                child->center_y = node->center_y + ((quadrant & 2) ? half : -half);
+                child->half_size = half;
+                child->depth = node->depth + 1;
+            }
+
+            node = child.get();
+        }
+
+        return node;
+    }
+
+    void Link(Id id)
+    {
+        Record& record = records_[id];
+        record.node = FindNode(GetBounds(record.shape));
+        record.slot = static_cast<std::uint32_t>(record.node->items.size());
+        record.node->items.push_back(id);
+    }
+
+    void Unlink(Id id)
+    {
+        Record& record = records_[id];
+        std::vector<Id>& items = record.node->items;
+        items[record.slot] = items.back();
+        records_[items.back()].slot = record.slot;
+        items.pop_back();
+        record.node = nullptr;
+    }
+
+    template <typename Overlaps, typename Test, typename Visit>
+    void Query(const Node& node, const Bounds& bounds, Overlaps overlaps, Test test, Visit& visit) const
+    {
+        for (Id id : node.items)
+        {
+            if (overlaps(GetBounds(records_[id].shape)) && test(records_[id].shape))
+            {
+                visit(id, records_[id].shape);
+            }
+        }
+
+        for (const std::unique_ptr<Node>& child : node.children)
+        {
+            if (child && GetLooseBounds(*child).Overlaps(bounds))
+            {
+                Query(*child, bounds, overlaps, test, visit);
+            }
+        }
+    }
+
+public:
+    // bounds is the region most shapes live in; shapes outside it still work but are all kept in the root.
+    explicit QuadTree(const Rect<T>& bounds, int max_depth = 16) : root_(std::make_unique<Node>()), max_depth_(max_depth), size_(0)
+    {
+        root_->half_size = std::max<double>(bounds.width_, bounds.height_) / 2.0;
+        root_->center_x = bounds.top_left_.x_ + root_->half_size;
+        root_->center_y = bounds.top_left_.y_ + root_->half_size;
+        root_->depth = 0;
+    }
+
+    Id Insert(const Shape& shape)
+    {
+        Id id = static_cast<Id>(records_.size());
+
+        if (free_ids_.empty())
+        {
+            records_.push_back({ shape, nullptr, 0 });
+        }
+        else
+        {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+            records_[id].shape = shape;
+        }
+
+        Link(id);
+        ++size_;
+        return id;
+    }
+
+    bool Remove(Id id)
+    {
+        if (!Contains(id))
+        {
+            return false;
+        }
+
+        Unlink(id);
+        free_ids_.push_back(id);
+        --size_;
+        return true;
+    }
+
+    // Relinks only when the shape leaves its node's cell or stops fitting it.
+    bool Move(Id id, const Shape& shape)
+    {
+        if (!Contains(id))
+        {
+            return false;
+        }
+
+        Record& record = records_[id];
+        record.shape = shape;
+        const Node* node = record.node;
+        const Bounds bounds = GetBounds(shape);
+        const double center_x = (bounds.min_x + bounds.max_x) / 2.0;
+        const double center_y = (bounds.min_y + bounds.max_y) / 2.0;
+        const double extent = std::max(bounds.max_x - bounds.min_x, bounds.max_y - bounds.min_y);
+
+        const bool still_fits = node != root_.get() && extent <= 2.0 * node->half_size && 
+            std::abs(center_x - node->center_x) <= node->half_size && std::abs(center_y - node->center_y) <= node->half_size;
+
+        if (!still_fits)
+        {
+            Unlink(id);
+            Link(id);
+        }
+
+        return true;
+    }
+
+    // Replaces the contents with shapes, whose ids become their indices. Shapes are linked in the Morton order of
+    // their centres, so neighbouring shapes are inserted together and the nodes they create stay warm in cache.
+    void BulkLoad(const std::vector<Shape>& shapes)
+    {
+        Clear();
+        records_.reserve(shapes.size());
+
+        std::vector<std::pair<std::uint64_t, Id>> order;
+        order.reserve(shapes.size());
+
+        const double scale = root_->half_size > 0.0 ? 65535.0 / (2.0 * root_->half_size) : 0.0;
+
+        const auto spread = [](std::uint64_t v)
+        {
+            v &= 0xffff;
+            v = (v | (v << 8)) & 0x00ff00ff;
+            v = (v | (v << 4)) & 0x0f0f0f0f;
+            v = (v | (v << 2)) & 0x33333333;
+            v = (v | (v << 1)) & 0x55555555;
+            return v;
+        };
+
+        for (const Shape& shape : shapes)
+        {
+            const Bounds bounds = GetBounds(shape);
+            const double x = ((bounds.min_x + bounds.max_x) / 2.0 - (root_->center_x - root_->half_size)) * scale;
+            const double y = ((bounds.min_y + bounds.max_y) / 2.0 - (root_->center_y - root_->half_size)) * scale;
+            const std::uint64_t cell_x = static_cast<std::uint64_t>(std::clamp(x, 0.0, 65535.0));
+            const std::uint64_t cell_y = static_cast<std::uint64_t>(std::clamp(y, 0.0, 65535.0));
+
+            order.push_back({ spread(cell_x) | (spread(cell_y) << 1), static_cast<Id>(records_.size()) });
+            records_.push_back({ shape, nullptr, 0 });
+        }
+
+        std::sort(order.begin(), order.end());
+
+        for (const auto& [code, id] : order)
+        {
+            Link(id);
+        }
+
+        size_ = shapes.size();
+    }
+
+    void Clear()
+    {
+        root_->children = {};
+        root_->items.clear();
+        records_.clear();
+        free_ids_.clear();
+        size_ = 0;
+    }
+
+    bool Contains(Id id) const
+    {
+        return id < records_.size() && records_[id].node != nullptr;
+    }
+
+    const Shape& Get(Id id) const
+    {
+        return records_[id].shape;
+    }
+
+    std::size_t GetSize() const
+    {
+        return size_;
+    }
+
+    // The visitors are called as visit(Id, const Shape&) for every shape that passes the shape's own predicate.
+    template <typename Visit>
+    void QueryPoint(const Point<T>& point, Visit visit) const
+    {
+        const Bounds bounds = { static_cast<double>(point.x_), static_cast<double>(point.y_), static_cast<double>(point.x_), static_cast<double>(point.y_) };
+
+        Query(*root_, bounds, [&bounds](const Bounds& shape_bounds) { return shape_bounds.Overlaps(bounds); },
+            [&point](const Shape& shape) { return shape.Contains(point); }, visit);
+    }
+
+    template <typename Visit>
+    void QueryRect(const Rect<T>& rect, Visit visit) const
+    {
+        const Bounds bounds = GetBounds(rect);
+
+        Query(*root_, bounds, [&bounds](const Bounds& shape_bounds) { return shape_bounds.Overlaps(bounds); },
+            [&rect](const Shape& shape) { return shape.Intersects(rect); }, visit);
+    }
+
+    template <typename Visit>
+    void QueryCircle(const Circle<T>& circle, Visit visit) const
+    {
+        const Bounds bounds = GetBounds(circle);
+
+        Query(*root_, bounds, [&bounds](const Bounds& shape_bounds) { return shape_bounds.Overlaps(bounds); },
+            [&circle](const Shape& shape)
+            {
+                if constexpr (std::is_same_v<Shape, Circle<T>>)
+                {
+                    return shape.Intersects(circle);
+                }
+                else
+                {
+                    return circle.Intersects(shape);
+                }
+            }, visit);
+    }
+
+    std::vector<Id> QueryPoint(const Point<T>& point) const
+    {
+        std::vector<Id> ids;
+        QueryPoint(point, [&ids](Id id, const Shape&) { ids.push_back(id); });
+        return ids;
+    }
+
+    std::vector<Id> QueryRect(const Rect<T>& rect) const
+    {
+        std::vector<Id> ids;
+        QueryRect(rect, [&ids](Id id, const Shape&) { ids.push_back(id); });
+        return ids;
+    }
+
+    std::vector<Id> QueryCircle(const Circle<T>& circle) const
+    {
+        std::vector<Id> ids;
+        QueryCircle(circle, [&ids](Id id, const Shape&) { ids.push_back(id); });
+        return ids;
+    }
+};
+
+#endif
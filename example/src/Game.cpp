@@ -1,6 +1,9 @@
 #include "Game.hpp"
 #include "Constants.hpp"
-#include "CircleTexture.hpp"
+#include "CircleShape.hpp"
+#include "DamageTracker.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
@@ -12,14 +15,24 @@
 Game::Game() : 
 	initialized_(false), 
 	running_(false), 
-	circle_texture_(nullptr)
+	circle_(nullptr), 
+	framebuffer_texture_(nullptr), 
+	damage_({ 0, 0, constants::screen_width, constants::screen_height })
 {
 	initialized_ = Initialize();
 
+	if (!initialized_)
+	{
+		return;
+	}
+
 	const SDL_Color color = { 0x00, 0x00, 0xff, 0xff };
 	const SDL_Point center = { static_cast<int>(constants::screen_width / 2), static_cast<int>(constants::screen_height / 2) };
 	constexpr int radius = 100;
-	circle_texture_ = std::make_unique<CircleTexture>(renderer_, center, radius, color);
+	circle_ = std::make_unique<CircleShape>(center, radius, color);
+
+	framebuffer_texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, constants::screen_width, constants::screen_height);
+	damage_.AddAll();
 }
 
 Game::~Game()
@@ -69,6 +82,11 @@ bool Game::Initialize()
 
 void Game::Finalize()
 {
+	circle_.reset();
+
+	SDL_DestroyTexture(framebuffer_texture_);
+	framebuffer_texture_ = nullptr;
+
 	SDL_DestroyWindow(window_);
 	window_ = nullptr;
 	
@@ -140,6 +158,10 @@ void Game::HandleEvents()
 			running_ = false;
 			return;
 		}
+		if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_EXPOSED)
+		{
+			damage_.AddAll();
+		}
 		if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT)
 		{
 			//SDL_GetMouseState(&mouse_pos_.x, &mouse_pos_.y);
@@ -150,16 +172,52 @@ void Game::HandleEvents()
 void Game::Tick()
 {
 	SDL_GetMouseState(&mouse_pos_.x, &mouse_pos_.y);
-	circle_texture_->MoveTo({ mouse_pos_.x, mouse_pos_.y });
+
+	const SDL_Rect old_bbox = circle_->GetBoundingBox();
+	circle_->MoveTo({ mouse_pos_.x, mouse_pos_.y });
+	const SDL_Rect& new_bbox = circle_->GetBoundingBox();
+
+	if (old_bbox.x != new_bbox.x || old_bbox.y != new_bbox.y)
+	{
+		damage_.AddMove(old_bbox, new_bbox);
+	}
 }
 
 void Game::Render()
 {
-	SDL_RenderSetViewport(renderer_, NULL);
-	SDL_SetRenderDrawColor(renderer_, 0xff, 0xff, 0xff, 0xff);
-	SDL_RenderClear(renderer_);
+	// Nothing changed, so the last presented frame is still correct.
+	if (damage_.IsEmpty())
+	{
+		return;
+	}
+
+	for (const SDL_Rect& region : damage_.GetRects())
+	{
+		void* pixels = nullptr;
+		int pitch = 0;
+
+		if (SDL_LockTexture(framebuffer_texture_, &region, &pixels, &pitch) == 0)
+		{
+			Composite({ static_cast<std::uint32_t*>(pixels), region.w, region.h, pitch / static_cast<int>(sizeof(std::uint32_t)) }, region);
+			SDL_UnlockTexture(framebuffer_texture_);
+		}
+	}
 
-	circle_texture_->Render();
-		
+	damage_.Clear();
+
+	// The back buffer is undefined after a present, so the whole framebuffer texture is copied; only the damaged
+	// regions were redrawn and uploaded.
+	SDL_RenderSetViewport(renderer_, NULL);
+	SDL_RenderCopy(renderer_, framebuffer_texture_, nullptr, nullptr);
 	SDL_RenderPresent(renderer_);
 }
+
+void Game::Composite(const raster::Surface& target, const SDL_Rect& region)
+{
+	raster::Clear(target, raster::PackARGB(0xff, 0xff, 0xff));
+
+	if (SDL_HasIntersection(&region, &circle_->GetBoundingBox()))
+	{
+		circle_->Draw(target, region.x, region.y);
+	}
+}
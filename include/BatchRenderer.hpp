@@ -0,0 +1,34 @@
+#ifndef BATCH_RENDERER_HPP
+#define BATCH_RENDERER_HPP
+
+#include "SDL2/SDL.h"
+
+#include <unordered_map>
+#include <vector>
+
+// Collects textured, tinted quads and submits all quads sharing a texture with a single SDL_RenderGeometry call.
+// Quads are drawn in submission order within a texture, and textures in the order they were first submitted.
+class BatchRenderer
+{
+private:
+	struct Batch
+	{
+		std::vector<SDL_Vertex> vertices;
+		std::vector<int> indices;
+	};
+
+	SDL_Renderer* renderer_;
+	std::vector<SDL_Texture*> textures_;
+	std::unordered_map<SDL_Texture*, Batch> batches_;
+
+public:
+	BatchRenderer(SDL_Renderer* renderer);
+
+	// tex_coords selects the normalised part of the texture to draw; by default the whole texture.
+	void Add(SDL_Texture* texture, const SDL_Rect& dst, const SDL_Color& color, const SDL_FRect& tex_coords = { 0.0f, 0.0f, 1.0f, 1.0f });
+
+	// Issues one draw call per texture and empties the batches, keeping their capacity for the next frame.
+	void Flush();
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include "SDL2/SDL.h"
+
+// Maps world coordinates to the screen: screen = (world - position) * zoom, with position the world point at the
+// top-left corner of the viewport.
+class Camera
+{
+private:
+	float x_;
+	float y_;
+	float zoom_;
+	int viewport_width_;
+	int viewport_height_;
+
+public:
+	Camera(int viewport_width, int viewport_height);
+
+	// Moves the view by the given number of screen pixels.
+	void Pan(float screen_dx, float screen_dy);
+
+	// Scales the zoom by factor, keeping the world point under (screen_x, screen_y) in place.
+	void ZoomAt(float factor, float screen_x, float screen_y);
+
+	void Reset();
+
+	float GetZoom() const;
+
+	SDL_FPoint WorldToScreen(float world_x, float world_y) const;
+
+	// Whether a screen-space rectangle overlaps the viewport at all.
+	bool IsVisible(const SDL_Rect& screen_rect) const;
+
+	SDL_Rect GetViewport() const;
+};
+
+#endif
@@ -1,34 +1,95 @@
 #ifndef CIRCLE_HPP
 #define CIRCLE_HPP
 
+#include "BatchRenderer.hpp"
+#include "Camera.hpp"
+#include "CircleMaskCache.hpp"
+#include "raster/Backend.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
 #include "SDL2/SDL.h"
 
+#include <cstddef>
+
 class Circle
 {
 private:
-	SDL_Renderer* renderer_;
+	CircleMaskCache* mask_cache_;
 	SDL_Point center_;
 	int radius_;
 	SDL_Rect bbox_;
 	SDL_Color color_;
-	Uint32 pixel_color_;
-	Uint32* pixels_;
-	SDL_Texture* texture_;
+	CircleMaskKey mask_key_;
+
+	// The cache entry currently held, which lags behind mask_key_ until the next AcquireMask or AcquireSpans. A
+	// reference is held while either form was acquired; the mask texture itself may be null if SDL could not
+	// create it, so holds_mask_ records the acquisition.
+	CircleMaskKey acquired_key_;
+	bool holds_mask_;
+	CircleMask mask_;
+	const raster::SpanList* spans_;
+
+	void UpdateBoundingBox();
+
+	// Like AcquireMask, for the shared scanline spans of the current shape at the given radius.
+	const raster::SpanList& AcquireSpans(int radius);
 
 public:
-	Circle(SDL_Renderer* renderer, SDL_Point center, int radius, SDL_Color color);
+	Circle(CircleMaskCache* mask_cache, SDL_Point center, int radius, SDL_Color color, bool filled, const raster::CircleBackend& backend = raster::GetDefaultCircleBackend());
 
 	~Circle();
 
-	void CreateCircleNaive();
+	Circle(const Circle&) = delete;
+
+	Circle& operator=(const Circle&) = delete;
+
+	// The setters only record the change. A new shape swaps in its mask on the next AcquireMask or Render, and a new
+	// colour never touches the mask since it is applied as a tint.
+	void SetRadius(int radius);
+
+	void SetColor(SDL_Color color);
+
+	void SetFilled(bool filled);
+
+	void SetBackend(const raster::CircleBackend& backend);
 
-	void CreateCircleBresenham(bool filled);
+	int GetRadius() const;
 
-	void CreateCircleChordEFLA(int x1, int y1, int x2, int y2);
+	SDL_Color GetColor() const;
+
+	const raster::CircleBackend& GetBackend() const;
+
+	// Takes a reference on the shared mask texture for the current shape at the given radius, normally the radius on
+	// screen so that the mask is drawn unscaled; Render does this on demand.
+	void AcquireMask(int radius);
+
+	// Gives the mask or spans back to the cache, for when the circle is drawn some other way.
+	void ReleaseMask();
 
 	void Tick();
 
-	void Render();
+	// Bounding box on screen: the centre is mapped through the camera and the radius scaled and rounded. A circle
+	// that shrinks below half a pixel keeps a 1x1 box.
+	SDL_Rect GetScreenRect(const Camera& camera) const;
+
+	// The three levels of detail, each drawn into the screen box dst at the screen radius. Render copies the shared
+	// mask texture of that radius, RenderPoint draws an untextured quad, and RenderSpans emits the scanline spans of
+	// the circle as untextured quads, skipping those outside viewport.
+	void Render(BatchRenderer& batch_renderer, const SDL_Rect& dst);
+
+	void RenderPoint(BatchRenderer& batch_renderer, const SDL_Rect& dst) const;
+
+	void RenderSpans(BatchRenderer& batch_renderer, const SDL_Rect& dst, const SDL_Rect& viewport);
+
+	// Pixel-exact hit tests against the rasterized shapes, through the cache's shared 1bpp coverage masks.
+	bool Overlaps(const Circle& other) const;
+
+	std::size_t CountOverlap(const Circle& other) const;
+
+	// Rasterizes the circle at its screen position and radius straight into a screen-sized framebuffer, clipped to
+	// its edges. Clipped and anti-aliased circles hold the cached spans of their screen radius.
+	void Draw(const raster::Surface& framebuffer, const Camera& camera);
 };
 
 #endif
@@ -0,0 +1,142 @@
+#ifndef CIRCLE_MASK_CACHE_HPP
+#define CIRCLE_MASK_CACHE_HPP
+
+#include "ThreadPool.hpp"
+#include "raster/Backend.hpp"
+#include "raster/CoverageMask.hpp"
+#include "raster/PixelPool.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include "SDL2/SDL.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// backend points into the registry of raster/Backend.hpp, whose entries never move, so it identifies the backend.
+struct CircleMaskKey
+{
+	int radius;
+	bool filled;
+	const raster::CircleBackend* backend;
+
+	friend bool operator==(const CircleMaskKey& lhs, const CircleMaskKey& rhs)
+	{
+		return lhs.radius == rhs.radius && lhs.filled == rhs.filled && lhs.backend == rhs.backend;
+	}
+};
+
+struct CircleMaskKeyHash
+{
+	std::size_t operator()(const CircleMaskKey& key) const
+	{
+		return (static_cast<std::size_t>(key.radius) << 1) ^ std::hash<const raster::CircleBackend*>()(key.backend) ^ static_cast<std::size_t>(key.filled);
+	}
+};
+
+// A shared mask: the part of texture given by tex_coords holds the circle's 2 * radius square.
+struct CircleMask
+{
+	SDL_Texture* texture;
+	SDL_FRect tex_coords;
+};
+
+// Rasterizes every distinct circle mask once, in white, so instances can share the texture and tint it with
+// colour modulation. The scanline spans and 1bpp coverage of a shape are cached in the same entry, for circles
+// drawn as spans and for hit tests, and each form is only built once it is first asked for. Entries are reference
+// counted; unreferenced ones stay cached until more than max_unused of them pile up, then the least recently used
+// is evicted with everything it holds.
+//
+// Textures are allocated in size classes a little larger than the mask, and evicted ones are kept as spares for
+// the next mask of the same class, so animating radii mostly recycles textures instead of creating them.
+//
+// Acquire only creates the streaming texture. The pixels of new masks are rasterized by Build: it locks every new
+// texture on the calling (render) thread, spreads the kernels over a thread pool to write straight into the locked
+// memory, and unlocks, so there is no CPU-side copy of a mask and no second pass to upload one. A texture that
+// cannot be locked is staged in a buffer from the scene's pixel pool and uploaded with SDL_UpdateTexture instead.
+class CircleMaskCache
+{
+private:
+	struct Entry
+	{
+		SDL_Texture* texture;
+		int capacity;
+		int ref_count;
+		std::list<CircleMaskKey>::iterator unused_it;
+		bool pending;
+		std::optional<raster::SpanList> spans;
+		std::optional<raster::CoverageMask> coverage;
+	};
+
+	SDL_Renderer* renderer_;
+	raster::PixelPool* pixel_pool_;
+	std::size_t max_unused_;
+	std::unordered_map<CircleMaskKey, Entry, CircleMaskKeyHash> entries_;
+	std::list<CircleMaskKey> unused_;
+	std::vector<CircleMaskKey> pending_;
+	std::unordered_map<int, std::vector<SDL_Texture*>> spare_textures_;
+	std::size_t spare_count_;
+	std::size_t rasterizations_;
+	std::size_t texture_creations_;
+
+	// Side of the square texture that holds a mask of the given side: at most a quarter larger, in steps of 8.
+	static int GetTextureCapacity(int size);
+
+	SDL_Texture* TakeTexture(int capacity);
+
+	// Draws the mask into the top-left 2 * radius square of surface, which may hold garbage.
+	static void Rasterize(const CircleMaskKey& key, const raster::Surface& surface);
+
+	// Finds or adds the entry of an already normalized key.
+	std::pair<const CircleMaskKey, Entry>& Find(const CircleMaskKey& key);
+
+	// Find, then takes a reference on the entry.
+	std::pair<const CircleMaskKey, Entry>& Reference(const CircleMaskKey& key);
+
+	void Evict(std::size_t max_unused);
+
+public:
+	CircleMaskCache(SDL_Renderer* renderer, raster::PixelPool* pixel_pool, std::size_t max_unused = 64);
+
+	~CircleMaskCache();
+
+	CircleMaskCache(const CircleMaskCache&) = delete;
+
+	CircleMaskCache& operator=(const CircleMaskCache&) = delete;
+
+	// Backends without outlines always fill, so the filled flag is ignored for them.
+	static CircleMaskKey Normalize(CircleMaskKey key);
+
+	// Returns the shared white mask for key. Every call must be paired with Release, and a new mask has no
+	// pixels until the next Build. A radius below 1 has no mask: the texture is null and no reference is taken.
+	CircleMask Acquire(const CircleMaskKey& key);
+
+	// Returns the shared scanline spans of key, which stay valid until the reference is released. Every call must
+	// be paired with Release, and no texture is created for an entry that is only used for its spans. A radius
+	// below 1 returns an empty list without taking a reference.
+	const raster::SpanList& AcquireSpans(const CircleMaskKey& key);
+
+	void Release(const CircleMaskKey& key);
+
+	// Rasterizes and uploads every mask acquired since the last call, on pool if given, otherwise inline.
+	void Build(ThreadPool* pool = nullptr);
+
+	// 1bpp coverage of key, built on first use. It needs no reference: an unreferenced entry counts as just used
+	// and goes through the same LRU, so the result stays valid until at least one more shape has been looked up,
+	// and for as long as the entry is held through Acquire or AcquireSpans.
+	const raster::CoverageMask& GetCoverage(const CircleMaskKey& key);
+
+	// Destroys every mask that is no longer referenced, and every spare texture.
+	void Trim();
+
+	std::size_t GetRasterizationCount() const;
+
+	std::size_t GetTextureCreationCount() const;
+};
+
+#endif
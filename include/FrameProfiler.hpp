@@ -0,0 +1,84 @@
+#ifndef FRAME_PROFILER_HPP
+#define FRAME_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class FramePhase
+{
+	handle_events,
+	tick,
+	render,
+	present,
+	count
+};
+
+struct FrameStats
+{
+	double p50;
+	double p95;
+	double p99;
+	double worst;
+	double mean;
+};
+
+// Times each phase of every frame with SDL_GetPerformanceCounter and keeps the most recent frames in a ring buffer,
+// so hitches show up in the percentiles instead of vanishing into a per-second average. Times are in milliseconds.
+class FrameProfiler
+{
+private:
+	static constexpr std::size_t phase_count = static_cast<std::size_t>(FramePhase::count);
+
+	struct Frame
+	{
+		std::uint64_t index;
+		std::uint64_t phases[phase_count];
+		std::uint64_t total;
+	};
+
+	std::vector<Frame> frames_;
+	std::size_t next_;
+	std::size_t size_;
+	std::uint64_t frame_count_;
+	Frame current_;
+	std::uint64_t frame_start_;
+	std::uint64_t phase_start_;
+	double ms_per_count_;
+
+	// Recorded frames, oldest first.
+	std::vector<const Frame*> GetFrames() const;
+
+	double ToMs(std::uint64_t counts) const;
+
+public:
+	explicit FrameProfiler(std::size_t capacity = 1024);
+
+	void BeginFrame();
+
+	void EndFrame();
+
+	// Phases may be entered several times per frame, as tick is; their times add up.
+	void BeginPhase();
+
+	void EndPhase(FramePhase phase);
+
+	std::size_t GetFrameCount() const;
+
+	FrameStats GetStats(FramePhase phase) const;
+
+	// Whole frames, including time outside the phases.
+	FrameStats GetFrameStats() const;
+
+	// One row per recorded frame.
+	bool WriteCsv(const char* path) const;
+
+	// Every recorded frame plus the statistics of each phase.
+	bool WriteJson(const char* path) const;
+
+	void PrintSummary() const;
+
+	static const char* GetPhaseName(FramePhase phase);
+};
+
+#endif
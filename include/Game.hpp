@@ -3,40 +3,85 @@
 
 #include <SDL2/SDL.h>
 
+#include "BatchRenderer.hpp"
+#include "Camera.hpp"
 #include "Circle.hpp"
+#include "CircleMaskCache.hpp"
+#include "FrameProfiler.hpp"
+#include "GameOptions.hpp"
+#include "ThreadPool.hpp"
+#include "raster/PixelPool.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 class Game
 {
 private:
+	GameOptions options_;
 	bool initialized_;
 	bool running_;
 	int game_ticks_;
+	bool animating_;
 	
 	SDL_Window* window_;
 	SDL_Renderer* renderer_;
 
+	std::unique_ptr<BatchRenderer> batch_renderer_;
+	std::unique_ptr<ThreadPool> thread_pool_;
+	std::unique_ptr<raster::PixelPool> pixel_pool_;
+	std::unique_ptr<CircleMaskCache> mask_cache_;
 	std::vector<std::unique_ptr<Circle>> circles_;
 
+	// Framebuffer mode: every circle is rasterized straight into the locked memory of one screen-sized streaming
+	// texture, once per frame.
+	bool framebuffer_mode_;
+	SDL_Texture* framebuffer_texture_;
+
+	Camera camera_;
+
+	FrameProfiler frame_profiler_;
+
+	// Time taken by InitializeCircles, including the parallel build of the masks for the initial view.
+	double construction_ms_;
+
 public:
-	Game();
+	explicit Game(const GameOptions& options = GameOptions());
 
 	~Game();
 
 	bool Initialize();
 
+	bool IsInitialized() const;
+
 	void Finalize();
 
 	void Run();
 
 	void HandleEvents();
+
+	// Switches every circle to the next registered rasterizer backend.
+	void CycleBackend();
+
+	// Arrows pan by a fixed number of screen pixels, = and - zoom about the centre of the screen and 0 resets.
+	void HandleCameraKey(SDL_Keycode key);
 	
 	void Tick();
 	
 	void Render();
 
+	void RenderFramebuffer();
+
+	void SetFramebufferMode(bool enabled);
+
+	// Writes the recent frame times to frame_profile.csv and frame_profile.json and prints their percentiles.
+	void DumpFrameProfile() const;
+
+	// Prints construction time, frames per second, frame-time percentiles and peak memory after a run with a frame
+	// count.
+	void PrintStressReport(int frames, double seconds) const;
+
 	bool InitializeCircles();
 };
 
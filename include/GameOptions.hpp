@@ -0,0 +1,49 @@
+#ifndef GAME_OPTIONS_HPP
+#define GAME_OPTIONS_HPP
+
+#include "raster/Backend.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+enum class RadiusDistribution
+{
+	uniform,
+	// Uniform in log(radius), so small circles dominate the way they do in most real scenes.
+	log_uniform
+};
+
+// Scene and run settings from the command line. The defaults reproduce the interactive demo: 100 circles of radius
+// 50, half of them filled, in a window that runs until it is closed.
+struct GameOptions
+{
+	std::size_t circle_count = 100;
+	int min_radius = 50;
+	int max_radius = 50;
+	RadiusDistribution radius_distribution = RadiusDistribution::uniform;
+	double filled_fraction = 0.5;
+	const raster::CircleBackend* backend = &raster::GetDefaultCircleBackend();
+
+	// Without a seed the scene is different on every run.
+	std::optional<std::uint32_t> seed;
+
+	// With a frame count the demo exits after that many frames and prints a stress report, and every frame runs
+	// exactly one tick so that the work does not depend on how fast the machine is.
+	int frame_count = 0;
+
+	bool animating = false;
+	bool framebuffer_mode = false;
+
+	// Selects an SDL video driver such as dummy or offscreen through SDL_HINT_VIDEODRIVER and renders in software,
+	// for machines without a display.
+	std::string video_driver;
+};
+
+void PrintGameUsage(const char* program);
+
+// Returns false, after printing the usage, on an unknown option or a malformed value.
+bool ParseGameOptions(int argc, char* argv[], GameOptions& options);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for CPU-only work such as rasterizing pixel buffers. Tasks must not call SDL.
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers_;
+	std::deque<std::function<void()>> tasks_;
+	std::mutex mutex_;
+	std::condition_variable task_ready_;
+	std::condition_variable tasks_done_;
+	std::size_t busy_;
+	bool stopping_;
+
+	void WorkerLoop();
+
+public:
+	// Zero threads means one per hardware thread.
+	explicit ThreadPool(std::size_t thread_count = 0);
+
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void Submit(std::function<void()> task);
+
+	// Blocks until every submitted task has finished.
+	void Wait();
+
+	// Calls fn(i) for every i in [0, count) across the workers and the calling thread, and returns when all are done.
+	void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+};
+
+#endif
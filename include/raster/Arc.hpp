@@ -0,0 +1,35 @@
+#ifndef RASTER_ARC_HPP
+#define RASTER_ARC_HPP
+
+#include "raster/Surface.hpp"
+
+#include <cstdint>
+
+namespace raster
+{
+	// Angular range of an arc as two integer direction vectors, swept counterclockwise on screen from start to end,
+	// with angles measured from the +x axis and y pointing up. Reflex ranges sweep more than 180 degrees.
+	struct ArcRange
+	{
+		int start_x;
+		int start_y;
+		int end_x;
+		int end_y;
+		bool reflex;
+		bool full;
+		bool empty;
+	};
+
+	// The only trigonometry: the two boundary directions are computed once per range, not per pixel.
+	ArcRange MakeArcRange(double start_degrees, double sweep_degrees);
+
+	// Whether the direction (dx, dy), y up, lies in the range, boundaries included. Two integer cross products.
+	bool IsInArc(const ArcRange& range, std::int64_t dx, std::int64_t dy);
+
+	// Part of a Bresenham circle with its 2 * radius bounding box at (x, y), clipped to the surface. The outline is
+	// the CircleBresenham octant walk with each mirrored pixel kept if its centre lies in the range; the filled pie
+	// is the CircleSpanFill disc cut by the range's half-planes, at most two spans per row.
+	void DrawArc(const Surface& surface, int x, int y, int radius, const ArcRange& range, bool filled, std::uint32_t color);
+} // namespace raster
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef RASTER_BACKEND_HPP
+#define RASTER_BACKEND_HPP
+
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+
+namespace raster
+{
+	// A named circle rasterizer. draw writes into the top-left 2 * radius square of the surface like the kernels in
+	// Kernels.hpp, and spans returns the same pixels in span form, for callers that clip, blend or work at sizes where
+	// a box would be too large.
+	struct CircleBackend
+	{
+		const char* name;
+		void (*draw)(const Surface& surface, int radius, bool filled, std::uint32_t color);
+		SpanList (*spans)(int radius, bool filled);
+
+		// Backends without outlines always fill and ignore the filled flag.
+		bool outline;
+
+		// Edge pixels carry partial coverage in their alpha, so draw onto a cleared surface and blend the result.
+		bool anti_aliased;
+	};
+
+	// Every registered backend, built-ins first: naive (on the widest SIMD level the CPU supports), one naive_<level>
+	// per supported level, bresenham, span_fill, spans and wu. Elements never move, so pointers to them stay valid.
+	const std::deque<CircleBackend>& GetCircleBackends();
+
+	// Returns nullptr for an unknown name.
+	const CircleBackend* FindCircleBackend(std::string_view name);
+
+	// bresenham, the backend the demo has always drawn with.
+	const CircleBackend& GetDefaultCircleBackend();
+
+	// Adds a backend under a new name and returns false if the name is taken. Not thread-safe: register before
+	// anything draws through the registry.
+	bool RegisterCircleBackend(const CircleBackend& backend);
+
+	struct CrossCheckResult
+	{
+		// Pixels whose values differ, plus pixels of the border around the box that either backend wrote, and the
+		// first of them in row order relative to the box, so outside it for a border write. (-1, -1) if there are none.
+		std::size_t mismatches;
+		int first_x;
+		int first_y;
+
+		// Time of one draw in nanoseconds, averaged over enough draws to fill a sample.
+		double ns_a;
+		double ns_b;
+	};
+
+	// Runs both backends on the same cleared 2 * radius box, inside a border of canary pixels, and compares the results
+	// pixel by pixel, then times each.
+	// A mode that one of them cannot draw is compared in the form that backend falls back to, so a fill-only backend
+	// checked against outlines reports every outline as a mismatch.
+	CrossCheckResult CrossCheck(const CircleBackend& a, const CircleBackend& b, int radius, bool filled, std::uint32_t color, double min_sample_ms = 1.0);
+} // namespace raster
+
+#endif
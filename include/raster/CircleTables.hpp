@@ -0,0 +1,174 @@
+#ifndef RASTER_CIRCLE_TABLES_HPP
+#define RASTER_CIRCLE_TABLES_HPP
+
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Compile-time versions of the Bresenham tables. The octant walk depends on nothing but the radius, so for a
+// radius known at compile time it is run by the compiler and the blitters below unroll into straight-line stores.
+namespace raster
+{
+	// One step of the octant walk, as offsets from the centre corner.
+	struct OctantStep
+	{
+		int x;
+		int y;
+	};
+
+	// The walk BresenhamHalfWidths runs; usable in constant expressions.
+	constexpr void WalkHalfWidths(int radius, int* half_widths)
+	{
+		for (int i = 0; i < radius; ++i)
+		{
+			half_widths[i] = 0;
+		}
+
+		int x = 0;
+		int y = radius;
+		int d = 1 - radius;
+
+		while (x < y)
+		{
+			if (d < 0)
+			{
+				d = d + 2 * x + 3;
+				++x;
+			}
+			else
+			{
+				d = d + 2 * (x - y) + 5;
+				++x;
+				--y;
+			}
+
+			const int row = std::max(y, 1) - 1;
+			half_widths[row] = std::max(half_widths[row], x);
+			half_widths[x - 1] = std::max(half_widths[x - 1], y);
+		}
+	}
+
+	constexpr int OctantStepCount(int radius)
+	{
+		int count = 0;
+		int x = 0;
+		int y = radius;
+		int d = 1 - radius;
+
+		while (x < y)
+		{
+			if (d >= 0)
+			{
+				d += 2 * (x - y) + 5;
+				--y;
+			}
+			else
+			{
+				d += 2 * x + 3;
+			}
+
+			++x;
+			++count;
+		}
+
+		return count;
+	}
+
+	template <int Radius>
+	struct CircleTable
+	{
+		static_assert(Radius > 0, "circle tables need a positive radius");
+
+		// Same layout as BresenhamHalfWidths.
+		std::array<int, Radius> half_widths;
+
+		// Every step of CircleBresenham's walk, each mirrored eight ways when drawn.
+		std::array<OctantStep, OctantStepCount(Radius)> steps;
+	};
+
+	template <int Radius>
+	constexpr CircleTable<Radius> MakeCircleTable()
+	{
+		CircleTable<Radius> table = {};
+		WalkHalfWidths(Radius, table.half_widths.data());
+
+		int x = 0;
+		int y = Radius;
+		int d = 1 - Radius;
+
+		for (OctantStep& step : table.steps)
+		{
+			if (d < 0)
+			{
+				d = d + 2 * x + 3;
+				++x;
+			}
+			else
+			{
+				d = d + 2 * (x - y) + 5;
+				++x;
+				--y;
+			}
+
+			step = { x, y };
+		}
+
+		return table;
+	}
+
+	template <int Radius>
+	inline constexpr CircleTable<Radius> circle_table = MakeCircleTable<Radius>();
+
+	namespace detail
+	{
+		template <int Radius, std::size_t... I>
+		void FillCircleFixed(const Surface& surface, std::uint32_t color, std::index_sequence<I...>)
+		{
+			constexpr const CircleTable<Radius>& table = circle_table<Radius>;
+
+			((std::fill_n(surface.Row(Radius - 1 - static_cast<int>(I)) + Radius - table.half_widths[I], 2 * table.half_widths[I], color),
+				std::fill_n(surface.Row(Radius + static_cast<int>(I)) + Radius - table.half_widths[I], 2 * table.half_widths[I], color)), ...);
+		}
+
+		template <int Radius>
+		void PlotOctants(const Surface& surface, OctantStep step, std::uint32_t color)
+		{
+			surface.At(Radius - step.x, Radius - step.y) = color;
+			surface.At(Radius - 1 + step.x, Radius - step.y) = color;
+			surface.At(Radius - step.y, Radius - step.x) = color;
+			surface.At(Radius - 1 + step.y, Radius - step.x) = color;
+			surface.At(Radius - step.y, Radius - 1 + step.x) = color;
+			surface.At(Radius - 1 + step.y, Radius - 1 + step.x) = color;
+			surface.At(Radius - step.x, Radius - 1 + step.y) = color;
+			surface.At(Radius - 1 + step.x, Radius - 1 + step.y) = color;
+		}
+
+		template <int Radius, std::size_t... I>
+		void OutlineCircleFixed(const Surface& surface, std::uint32_t color, std::index_sequence<I...>)
+		{
+			(PlotOctants<Radius>(surface, circle_table<Radius>.steps[I], color), ...);
+		}
+	} // namespace detail
+
+	// Unrolled equivalents of CircleSpanFill and the outline CircleBresenham for a compile-time radius.
+	template <int Radius>
+	void FillCircleFixed(const Surface& surface, std::uint32_t color)
+	{
+		detail::FillCircleFixed<Radius>(surface, color, std::make_index_sequence<Radius>());
+	}
+
+	template <int Radius>
+	void OutlineCircleFixed(const Surface& surface, std::uint32_t color)
+	{
+		detail::OutlineCircleFixed<Radius>(surface, color, std::make_index_sequence<OctantStepCount(Radius)>());
+	}
+
+	// Largest radius the runtime kernels hand to the unrolled blitters.
+	constexpr int max_fixed_radius = 16;
+} // namespace raster
+
+#endif
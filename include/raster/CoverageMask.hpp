@@ -0,0 +1,60 @@
+#ifndef RASTER_COVERAGE_MASK_HPP
+#define RASTER_COVERAGE_MASK_HPP
+
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raster
+{
+	// One bit per pixel: bit i of word w in a row is column 64 * w + i. Bits past the width are always clear, so
+	// whole words can be combined without masking the row ends.
+	class CoverageMask
+	{
+	private:
+		int width_;
+		int height_;
+		int words_per_row_;
+		std::vector<std::uint64_t> words_;
+
+	public:
+		CoverageMask();
+
+		CoverageMask(int width, int height);
+
+		// Every non-zero pixel counts as covered, including anti-aliased edge pixels of any alpha.
+		static CoverageMask FromSurface(const Surface& surface);
+
+		// Every span with non-zero coverage, O(spans) instead of a pass over a rasterized box.
+		static CoverageMask FromSpans(const SpanList& spans);
+
+		// Covers columns [x_begin, x_end) of row y.
+		void SetSpan(int y, int x_begin, int x_end);
+
+		bool Test(int x, int y) const;
+
+		std::size_t Count() const;
+
+		const std::uint64_t* Row(int y) const;
+
+		int GetWidth() const;
+
+		int GetHeight() const;
+
+		int GetWordsPerRow() const;
+	};
+
+	// Bresenham circle coverage, the same pixels as CircleBresenham. Filled masks are built from the half-width
+	// table without touching a 32-bit buffer.
+	CoverageMask CircleCoverage(int radius, bool filled);
+
+	// Pixel-exact tests between mask a with its top-left at (ax, ay) and mask b at (bx, by), 64 pixels per AND.
+	bool Overlaps(const CoverageMask& a, int ax, int ay, const CoverageMask& b, int bx, int by);
+
+	std::size_t CountOverlap(const CoverageMask& a, int ax, int ay, const CoverageMask& b, int bx, int by);
+} // namespace raster
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef RASTER_DRAW_HPP
+#define RASTER_DRAW_HPP
+
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstdint>
+
+// Circles positioned anywhere on a shared surface such as a screen framebuffer. (x, y) is the top-left corner of the
+// circle's 2 * radius bounding box and may lie partly or wholly outside the surface; output is clipped to it and
+// matches the corresponding kernel in Kernels.hpp, or DrawSpans the span form, pixel for pixel.
+namespace raster
+{
+	void DrawCircleBresenham(const Surface& surface, int x, int y, int radius, bool filled, std::uint32_t color);
+
+	// Writes the spans with their top-left at (x, y), as bulk fills of color with its alpha scaled by each span's
+	// coverage. Replaces the pixels like the kernels do.
+	void DrawSpans(const Surface& surface, int x, int y, const SpanList& spans, std::uint32_t color);
+
+	// Same as DrawSpans but blends the scaled colour over the existing pixels.
+	void TintSpans(const Surface& surface, int x, int y, const SpanList& spans, std::uint32_t color);
+} // namespace raster
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef RASTER_LINE_HPP
+#define RASTER_LINE_HPP
+
+#include "raster/Surface.hpp"
+
+#include <cstdint>
+
+namespace raster
+{
+	// Draws the segment from (x1, y1) to (x2, y2), both endpoints included, stepping along the major axis with an
+	// exact integer error term. Endpoints may lie anywhere; the segment is clipped to the surface without changing
+	// which pixels it covers. Horizontal, vertical and 45 degree segments take dedicated paths.
+	void DrawLine(const Surface& surface, int x1, int y1, int x2, int y2, std::uint32_t color);
+} // namespace raster
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef RASTER_PIXEL_POOL_HPP
+#define RASTER_PIXEL_POOL_HPP
+
+#include "raster/Surface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raster
+{
+	class PixelPool;
+
+	// Pixel storage borrowed from a PixelPool, returned to it on destruction or Release.
+	class PixelBuffer
+	{
+	private:
+		PixelPool* pool_;
+		std::uint32_t* pixels_;
+		int size_class_;
+
+		friend class PixelPool;
+
+		PixelBuffer(PixelPool* pool, std::uint32_t* pixels, int size_class);
+
+	public:
+		PixelBuffer();
+
+		~PixelBuffer();
+
+		PixelBuffer(PixelBuffer&& other) noexcept;
+
+		PixelBuffer& operator=(PixelBuffer&& other) noexcept;
+
+		PixelBuffer(const PixelBuffer&) = delete;
+
+		PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+		std::uint32_t* GetPixels() const;
+
+		// Number of pixels the buffer can hold, at least the number requested.
+		std::size_t GetCapacity() const;
+
+		// Tightly packed width x height surface over the buffer.
+		Surface GetSurface(int width, int height) const;
+
+		void Release();
+	};
+
+	struct PixelPoolStats
+	{
+		std::size_t requests;
+		std::size_t heap_allocations;
+		std::size_t bytes_in_use;
+		std::size_t peak_bytes_in_use;
+		std::size_t bytes_reserved;
+		std::size_t peak_bytes_reserved;
+	};
+
+	// Size-class pool of pixel buffers. Capacities are powers of two from 64 pixels up, and released buffers are kept
+	// on a free list per class for the next request, so staging buffers are recycled instead of going back to the
+	// heap. Not thread-safe: acquire and release on one thread, and only write the pixels from others.
+	class PixelPool
+	{
+	private:
+		std::vector<std::vector<std::uint32_t*>> free_lists_;
+		PixelPoolStats stats_;
+
+		friend class PixelBuffer;
+
+		void Return(std::uint32_t* pixels, int size_class);
+
+	public:
+		PixelPool();
+
+		// Every buffer must have been released before the pool is destroyed.
+		~PixelPool();
+
+		PixelPool(const PixelPool&) = delete;
+
+		PixelPool& operator=(const PixelPool&) = delete;
+
+		PixelBuffer Acquire(std::size_t pixels);
+
+		// Frees every buffer on the free lists.
+		void Trim();
+
+		const PixelPoolStats& GetStats() const;
+
+		static std::size_t GetClassCapacity(int size_class);
+	};
+} // namespace raster
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef RASTER_SPAN_LIST_HPP
+#define RASTER_SPAN_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raster
+{
+	// Pixels [x_begin, x_end) of row y, all with the same coverage out of 255.
+	struct Span
+	{
+		int y;
+		int x_begin;
+		int x_end;
+		std::uint8_t coverage;
+	};
+
+	// Run-length form of a width x height shape, sorted by row and then column, with no two spans touching unless
+	// their coverage differs. Solid shapes take O(radius) spans instead of O(radius^2) pixels.
+	struct SpanList
+	{
+		int width;
+		int height;
+		std::vector<Span> spans;
+	};
+
+	// Span forms of the circle kernels, pixel for pixel. The Bresenham outline is generated from one octant and the
+	// Wu spans from one quadrant of the Wu kernel's edge pixels, so both cost O(radius) rather than a 2 * radius box;
+	// Wu edge pixels become short spans of equal coverage.
+	SpanList CircleSpansNaive(int radius);
+
+	SpanList CircleSpansBresenham(int radius, bool filled);
+
+	SpanList CircleSpansWu(int radius, bool filled);
+
+	// Little-endian: width, height and span count as 32-bit values, then 7 bytes per span (16-bit y, x_begin and
+	// x_end, 8-bit coverage), so sizes are limited to 65535. Returns false, leaving data untouched, for a larger list
+	// or a span outside its bounds rather than writing truncated fields.
+	bool SerializeSpans(const SpanList& spans, std::vector<std::uint8_t>& data);
+
+	// Returns false, leaving spans untouched, if data is truncated or describes spans outside its own bounds.
+	bool DeserializeSpans(const std::uint8_t* data, std::size_t size, SpanList& spans);
+} // namespace raster
+
+#endif
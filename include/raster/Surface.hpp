@@ -0,0 +1,35 @@
+#ifndef RASTER_SURFACE_HPP
+#define RASTER_SURFACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace raster
+{
+	// Caller-owned 32-bit pixel memory. Stride is measured in pixels, not bytes.
+	struct Surface
+	{
+		std::uint32_t* pixels;
+		int width;
+		int height;
+		int stride;
+
+		std::uint32_t* Row(int y) const
+		{
+			return pixels + static_cast<std::ptrdiff_t>(y) * stride;
+		}
+
+		std::uint32_t& At(int x, int y) const
+		{
+			return Row(y)[x];
+		}
+
+		// View of the given sub-rectangle sharing the same memory. The rectangle must lie inside the surface.
+		Surface Sub(int x, int y, int w, int h) const
+		{
+			return { Row(y) + x, w, h, stride };
+		}
+	};
+} // namespace raster
+
+#endif
@@ -0,0 +1,58 @@
+#include "BatchRenderer.hpp"
+
+#include "SDL2/SDL.h"
+
+#include <iterator>
+
+BatchRenderer::BatchRenderer(SDL_Renderer* renderer) : 
+	renderer_(renderer)
+{
+}
+
+void BatchRenderer::Add(SDL_Texture* texture, const SDL_Rect& dst, const SDL_Color& color, const SDL_FRect& tex_coords)
+{
+	Batch& batch = batches_[texture];
+
+	if (batch.vertices.empty())
+	{
+		textures_.push_back(texture);
+	}
+
+	const int first = static_cast<int>(batch.vertices.size());
+	const float x0 = static_cast<float>(dst.x);
+	const float y0 = static_cast<float>(dst.y);
+	const float x1 = static_cast<float>(dst.x + dst.w);
+	const float y1 = static_cast<float>(dst.y + dst.h);
+	const float u0 = tex_coords.x;
+	const float v0 = tex_coords.y;
+	const float u1 = tex_coords.x + tex_coords.w;
+	const float v1 = tex_coords.y + tex_coords.h;
+
+	batch.vertices.push_back({ { x0, y0 }, color, { u0, v0 } });
+	batch.vertices.push_back({ { x1, y0 }, color, { u1, v0 } });
+	batch.vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+	batch.vertices.push_back({ { x0, y1 }, color, { u0, v1 } });
+
+	const int quad_indices[] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+	batch.indices.insert(batch.indices.end(), std::begin(quad_indices), std::end(quad_indices));
+}
+
+void BatchRenderer::Flush()
+{
+	// Drop batches of textures that were not drawn this frame; their textures may no longer exist.
+	for (auto it = batches_.begin(); it != batches_.end();)
+	{
+		it = it->second.vertices.empty() ? batches_.erase(it) : std::next(it);
+	}
+
+	for (SDL_Texture* texture : textures_)
+	{
+		Batch& batch = batches_[texture];
+		SDL_RenderGeometry(renderer_, texture, batch.vertices.data(), static_cast<int>(batch.vertices.size()), batch.indices.data(), static_cast<int>(batch.indices.size()));
+
+		batch.vertices.clear();
+		batch.indices.clear();
+	}
+
+	textures_.clear();
+}
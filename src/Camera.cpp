@@ -0,0 +1,64 @@
+#include "Camera.hpp"
+
+#include "SDL2/SDL.h"
+
+#include <algorithm>
+
+namespace
+{
+	constexpr float min_zoom = 1.0f / 64.0f;
+	constexpr float max_zoom = 64.0f;
+} // namespace
+
+Camera::Camera(int viewport_width, int viewport_height) : 
+	x_(0.0f), 
+	y_(0.0f), 
+	zoom_(1.0f), 
+	viewport_width_(viewport_width), 
+	viewport_height_(viewport_height)
+{
+}
+
+void Camera::Pan(float screen_dx, float screen_dy)
+{
+	x_ += screen_dx / zoom_;
+	y_ += screen_dy / zoom_;
+}
+
+void Camera::ZoomAt(float factor, float screen_x, float screen_y)
+{
+	const float world_x = x_ + screen_x / zoom_;
+	const float world_y = y_ + screen_y / zoom_;
+
+	zoom_ = std::clamp(zoom_ * factor, min_zoom, max_zoom);
+	x_ = world_x - screen_x / zoom_;
+	y_ = world_y - screen_y / zoom_;
+}
+
+void Camera::Reset()
+{
+	x_ = 0.0f;
+	y_ = 0.0f;
+	zoom_ = 1.0f;
+}
+
+float Camera::GetZoom() const
+{
+	return zoom_;
+}
+
+SDL_FPoint Camera::WorldToScreen(float world_x, float world_y) const
+{
+	return { (world_x - x_) * zoom_, (world_y - y_) * zoom_ };
+}
+
+bool Camera::IsVisible(const SDL_Rect& screen_rect) const
+{
+	return screen_rect.x < viewport_width_ && screen_rect.y < viewport_height_ && 
+		screen_rect.x + screen_rect.w > 0 && screen_rect.y + screen_rect.h > 0;
+}
+
+SDL_Rect Camera::GetViewport() const
+{
+	return { 0, 0, viewport_width_, viewport_height_ };
+}
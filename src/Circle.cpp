@@ -1,190 +1,247 @@
 #include "Circle.hpp"
+#include "BatchRenderer.hpp"
+#include "Camera.hpp"
+#include "CircleMaskCache.hpp"
+#include "raster/Backend.hpp"
+#include "raster/CoverageMask.hpp"
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
 
 #include "SDL2/SDL.h"
 
-#include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
-Circle::Circle(SDL_Renderer* renderer, SDL_Point center, int radius, SDL_Color color) : 
-	renderer_(renderer), 
+Circle::Circle(CircleMaskCache* mask_cache, SDL_Point center, int radius, SDL_Color color, bool filled, const raster::CircleBackend& backend) : 
+	mask_cache_(mask_cache), 
 	center_(center), 
 	radius_(radius), 
 	color_(color), 
-	pixel_color_(0), 
-	texture_(nullptr)
+	mask_key_({ radius, filled, &backend }), 
+	acquired_key_(mask_key_), 
+	holds_mask_(false), 
+	mask_({ nullptr, { 0.0f, 0.0f, 1.0f, 1.0f } }), 
+	spans_(nullptr)
 {
-	bbox_.x = center_.x - radius_;
-	bbox_.y = center_.y - radius_;
-	bbox_.w = 2 * radius_;
-	bbox_.h = 2 * radius_;
+	UpdateBoundingBox();
+}
 
-	#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-	pixel_color_ = (color_.b << 24) + (color_.g << 16) + (color_.r << 8) + 255;
-	#else
-	pixel_color_ = (255 << 24) + (color_.r << 16) + (color_.g << 8) + color_.b;
-	#endif
+Circle::~Circle()
+{
+	ReleaseMask();
+}
 
-	pixels_ = new Uint32[bbox_.w * bbox_.h];
-	texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, bbox_.w, bbox_.h);
-	SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+void Circle::SetRadius(int radius)
+{
+	radius_ = radius;
+	mask_key_.radius = radius;
+	UpdateBoundingBox();
+}
 
-	//CreateCircleNaive();
-	CreateCircleBresenham(std::rand() % 2);
+void Circle::SetColor(SDL_Color color)
+{
+	color_ = color;
 }
 
-Circle::~Circle()
+void Circle::SetFilled(bool filled)
 {
-	SDL_DestroyTexture(texture_);
-	texture_ = nullptr;
+	mask_key_.filled = filled;
+}
 
-	delete[] pixels_;
-	pixels_ = nullptr;
+void Circle::SetBackend(const raster::CircleBackend& backend)
+{
+	mask_key_.backend = &backend;
 }
 
-void Circle::CreateCircleNaive()
+int Circle::GetRadius() const
 {
-	for (int i = 0; i < bbox_.w * bbox_.h; ++i)
-	{
-		pixels_[i] = 0;
-	}
-	
-	const int cx = center_.x - bbox_.x;
-	const int cy = center_.y - bbox_.y;
-	const int radius_squared = radius_ * radius_;
+	return radius_;
+}
 
-	for (int x = 0; x < bbox_.w; ++x)
-	{
-		for (int y = 0; y < bbox_.h; ++y)
-		{
-			if ((x - cx) * (x - cx) + (y - cy) * (y - cy) - radius_squared <= 0)
-			{
-				pixels_[(y * bbox_.w) + x] = pixel_color_;
-			}
-		}		
-	}
+SDL_Color Circle::GetColor() const
+{
+	return color_;
+}
 
-	SDL_UpdateTexture(texture_, nullptr, pixels_, bbox_.w * sizeof(Uint32));
+const raster::CircleBackend& Circle::GetBackend() const
+{
+	return *mask_key_.backend;
 }
 
-void Circle::CreateCircleBresenham(bool filled)
+void Circle::AcquireMask(int radius)
 {
-	for (int i = 0; i < bbox_.w * bbox_.h; ++i)
+	const CircleMaskKey key = CircleMaskCache::Normalize({ radius, mask_key_.filled, mask_key_.backend });
+
+	if (holds_mask_ && acquired_key_ == key)
 	{
-		pixels_[i] = 0;
+		return;
 	}
 
-	int x = 0;
-	int y = radius_;
-	int d = 1 - radius_;
-
-	while (x < y)
+	// Nothing is drawn below a radius of 1, and the cache has no mask for it.
+	if (radius < 1)
 	{
-		if (d < 0)
-		{
-			d = d + 2 * x + 3;
-			++x;
-		}
-		else
-		{
-			d = d + 2 * (x - y) + 5;
-			++x;
-			--y;
-		}
-
-		pixels_[((radius_ - y) * bbox_.w) + (radius_ - x)] = pixel_color_;
-		pixels_[((radius_ - y) * bbox_.w) + (radius_ - 1 + x)] = pixel_color_;
-		pixels_[((radius_ - x) * bbox_.w) + (radius_ - y)] = pixel_color_;
-		pixels_[((radius_ - x) * bbox_.w) + (radius_ - 1 + y)] = pixel_color_;
-		pixels_[((radius_ - 1 + x) * bbox_.w) + (radius_ - y)] = pixel_color_;
-		pixels_[((radius_ - 1 + x) * bbox_.w) + (radius_ - 1 + y)] = pixel_color_;
-		pixels_[((radius_ - 1 + y) * bbox_.w) + (radius_ - x)] = pixel_color_;		
-		pixels_[((radius_ - 1 + y) * bbox_.w) + (radius_ - 1 + x)] = pixel_color_;
-
-		if (filled)
-		{
-			CreateCircleChordEFLA(radius_ - x, radius_ - y, radius_ - 1 + x, radius_ - y);
-			CreateCircleChordEFLA(radius_ - y, radius_ - x, radius_ - 1 + y, radius_ - x);
-			CreateCircleChordEFLA(radius_ - y, radius_ - 1 + x, radius_ - 1 + y, radius_ - 1 + x);
-			CreateCircleChordEFLA(radius_ - x, radius_ - 1 + y, radius_ - 1 + x, radius_ - 1 + y);
-		}
+		ReleaseMask();
+		return;
 	}
 
-	SDL_UpdateTexture(texture_, nullptr, pixels_, bbox_.w * sizeof(Uint32));
+	// The new mask is taken before the old one is let go, so a mask shared with other circles is never evicted
+	// and rebuilt in between.
+	const CircleMask mask = mask_cache_->Acquire(key);
+	ReleaseMask();
+	holds_mask_ = true;
+	mask_ = mask;
+	acquired_key_ = key;
 }
 
-void Circle::CreateCircleChordEFLA(int x1, int y1, int x2, int y2)
+const raster::SpanList& Circle::AcquireSpans(int radius)
 {
-	bool y_longer = false;
-	int increment_val = 0;
-	int end_val = 0;
-	int short_len = y2 - y1;
-	int long_len = x2 - x1;
+	const CircleMaskKey key = CircleMaskCache::Normalize({ radius, mask_key_.filled, mask_key_.backend });
 
-	if (std::abs(short_len) > std::abs(long_len))
+	if (spans_ != nullptr && acquired_key_ == key)
 	{
-		int swap = short_len;
-		short_len = long_len;
-		long_len = swap;
-		y_longer = true;
+		return *spans_;
 	}
 
-	end_val = long_len;
-
-	if (long_len < 0)
+	if (radius < 1)
 	{
-		increment_val = -1;
-		long_len = -long_len;
-	} 
-	else
-	{ 
-		increment_val = 1;
+		ReleaseMask();
+		return mask_cache_->AcquireSpans(key);
 	}
 
-	double dec_inc = 0.0;
+	const raster::SpanList& spans = mask_cache_->AcquireSpans(key);
+	ReleaseMask();
+	spans_ = &spans;
+	acquired_key_ = key;
+	return spans;
+}
 
-	if (long_len == 0)
+void Circle::ReleaseMask()
+{
+	if (holds_mask_ || spans_ != nullptr)
 	{
-		dec_inc = static_cast<double>(short_len);
-	} 
-	else
-	{ 
-		dec_inc = (static_cast<double>(short_len) / static_cast<double>(long_len));
+		mask_cache_->Release(acquired_key_);
+		holds_mask_ = false;
+		mask_.texture = nullptr;
+		spans_ = nullptr;
 	}
+}
 
-	double j = 0.0;
+void Circle::Tick()
+{
+}
 
-	if (y_longer)
+SDL_Rect Circle::GetScreenRect(const Camera& camera) const
+{
+	const SDL_FPoint center = camera.WorldToScreen(static_cast<float>(center_.x), static_cast<float>(center_.y));
+	const int radius = static_cast<int>(std::lround(radius_ * camera.GetZoom()));
+	const int x = static_cast<int>(std::lround(center.x));
+	const int y = static_cast<int>(std::lround(center.y));
+	const int size = std::max(2 * radius, 1);
+
+	return { x - radius, y - radius, size, size };
+}
+
+void Circle::Render(BatchRenderer& batch_renderer, const SDL_Rect& dst)
+{
+	AcquireMask(dst.w / 2);
+
+	// The mask is shared and white, so the colour is applied per instance through the vertex colour.
+	batch_renderer.Add(mask_.texture, dst, color_, mask_.tex_coords);
+}
+
+void Circle::RenderPoint(BatchRenderer& batch_renderer, const SDL_Rect& dst) const
+{
+	batch_renderer.Add(nullptr, dst, color_);
+}
+
+void Circle::RenderSpans(BatchRenderer& batch_renderer, const SDL_Rect& dst, const SDL_Rect& viewport)
+{
+	const raster::SpanList& spans = AcquireSpans(dst.w / 2);
+
+	for (const raster::Span& span : spans.spans)
 	{
-		for (int i = 0; i != end_val; i += increment_val)
+		const int y = dst.y + span.y;
+
+		if (y < viewport.y || y >= viewport.y + viewport.h)
 		{
-			pixels_[(y1 + i) * bbox_.w + (x1 + static_cast<int>(j))] = pixel_color_;
-			j += dec_inc;
+			continue;
 		}
-	} 
-	else 
-	{
-		for (int i = 0; i != end_val; i += increment_val)
+
+		const int x_begin = std::max(dst.x + span.x_begin, viewport.x);
+		const int x_end = std::min(dst.x + span.x_end, viewport.x + viewport.w);
+
+		if (x_begin < x_end)
 		{
-			pixels_[(y1 + static_cast<int>(j)) * bbox_.w + (x1 + i)] = pixel_color_;
-			j += dec_inc;
+			// Anti-aliased edge spans carry their coverage in the vertex alpha.
+			SDL_Color color = color_;
+			color.a = static_cast<Uint8>((color_.a * span.coverage + 127) / 255);
+			batch_renderer.Add(nullptr, { x_begin, y, x_end - x_begin, 1 }, color);
 		}
 	}
 }
 
+void Circle::UpdateBoundingBox()
+{
+	bbox_.x = center_.x - radius_;
+	bbox_.y = center_.y - radius_;
+	bbox_.w = 2 * radius_;
+	bbox_.h = 2 * radius_;
+}
 
-void Circle::Tick()
+bool Circle::Overlaps(const Circle& other) const
+{
+	if (!SDL_HasIntersection(&bbox_, &other.bbox_))
+	{
+		return false;
+	}
+
+	return raster::Overlaps(mask_cache_->GetCoverage(mask_key_), bbox_.x, bbox_.y, other.mask_cache_->GetCoverage(other.mask_key_), other.bbox_.x, other.bbox_.y);
+}
+
+std::size_t Circle::CountOverlap(const Circle& other) const
 {
+	if (!SDL_HasIntersection(&bbox_, &other.bbox_))
+	{
+		return 0;
+	}
+
+	return raster::CountOverlap(mask_cache_->GetCoverage(mask_key_), bbox_.x, bbox_.y, other.mask_cache_->GetCoverage(other.mask_key_), other.bbox_.x, other.bbox_.y);
 }
 
-void Circle::Render()
+void Circle::Draw(const raster::Surface& framebuffer, const Camera& camera)
 {
-	SDL_SetRenderDrawColor(renderer_, 0xff, 0xff, 0xff, 0xff);
-	SDL_RenderCopy(renderer_, texture_, nullptr, &bbox_);
+	const SDL_Rect dst = GetScreenRect(camera);
+	const std::uint32_t pixel_color = raster::PackARGB(color_.r, color_.g, color_.b, color_.a);
+
+	if (dst.w == 1)
+	{
+		if (dst.x >= 0 && dst.y >= 0 && dst.x < framebuffer.width && dst.y < framebuffer.height)
+		{
+			framebuffer.At(dst.x, dst.y) = pixel_color;
+		}
+
+		return;
+	}
 
-	SDL_Rect bbox_copy = bbox_;
-	bbox_copy.x -= 1;
-	bbox_copy.y -= 1;
-	bbox_copy.w += 2;
-	bbox_copy.h += 2;
-	//SDL_RenderDrawRect(renderer_, &bbox_copy);
+	const raster::CircleBackend& backend = *mask_key_.backend;
+	const int radius = dst.w / 2;
+
+	// Anti-aliased spans are blended over the circles below, and boxes that leave the framebuffer go through the
+	// clipped span form; everything else is drawn by the backend's own kernel.
+	if (backend.anti_aliased)
+	{
+		raster::TintSpans(framebuffer, dst.x, dst.y, AcquireSpans(radius), pixel_color);
+	}
+	else if (dst.x >= 0 && dst.y >= 0 && dst.x + dst.w <= framebuffer.width && dst.y + dst.h <= framebuffer.height)
+	{
+		backend.draw(framebuffer.Sub(dst.x, dst.y, dst.w, dst.h), radius, mask_key_.filled, pixel_color);
+	}
+	else
+	{
+		raster::DrawSpans(framebuffer, dst.x, dst.y, AcquireSpans(radius), pixel_color);
+	}
 }
@@ -0,0 +1,340 @@
+#include "CircleMaskCache.hpp"
+#include "ThreadPool.hpp"
+#include "raster/Backend.hpp"
+#include "raster/CoverageMask.hpp"
+#include "raster/PixelPool.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include "SDL2/SDL.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+CircleMaskCache::CircleMaskCache(SDL_Renderer* renderer, raster::PixelPool* pixel_pool, std::size_t max_unused) :
+	renderer_(renderer),
+	pixel_pool_(pixel_pool),
+	max_unused_(max_unused),
+	spare_count_(0),
+	rasterizations_(0),
+	texture_creations_(0)
+{
+}
+
+CircleMaskCache::~CircleMaskCache()
+{
+	for (auto& [key, entry] : entries_)
+	{
+		if (entry.texture != nullptr)
+		{
+			SDL_DestroyTexture(entry.texture);
+			entry.texture = nullptr;
+		}
+	}
+
+	for (auto& [capacity, textures] : spare_textures_)
+	{
+		for (SDL_Texture* texture : textures)
+		{
+			SDL_DestroyTexture(texture);
+		}
+	}
+}
+
+CircleMaskKey CircleMaskCache::Normalize(CircleMaskKey key)
+{
+	if (!key.backend->outline)
+	{
+		key.filled = true;
+	}
+
+	return key;
+}
+
+CircleMask CircleMaskCache::Acquire(const CircleMaskKey& key)
+{
+	if (key.radius < 1)
+	{
+		return { nullptr, { 0.0f, 0.0f, 1.0f, 1.0f } };
+	}
+
+	auto& [normalized, entry] = Reference(Normalize(key));
+	const int size = 2 * normalized.radius;
+
+	if (entry.texture == nullptr)
+	{
+		entry.capacity = GetTextureCapacity(size);
+		entry.texture = TakeTexture(entry.capacity);
+		entry.pending = true;
+		pending_.push_back(normalized);
+	}
+
+	const float extent = static_cast<float>(size) / static_cast<float>(entry.capacity);
+	return { entry.texture, { 0.0f, 0.0f, extent, extent } };
+}
+
+const raster::SpanList& CircleMaskCache::AcquireSpans(const CircleMaskKey& key)
+{
+	static const raster::SpanList empty = { 0, 0, {} };
+
+	if (key.radius < 1)
+	{
+		return empty;
+	}
+
+	auto& [normalized, entry] = Reference(Normalize(key));
+
+	if (!entry.spans)
+	{
+		entry.spans = normalized.backend->spans(normalized.radius, normalized.filled);
+	}
+
+	return *entry.spans;
+}
+
+std::pair<const CircleMaskKey, CircleMaskCache::Entry>& CircleMaskCache::Find(const CircleMaskKey& key)
+{
+	auto it = entries_.find(key);
+
+	if (it == entries_.end())
+	{
+		it = entries_.emplace(key, Entry{ nullptr, 0, 0, unused_.end(), false, std::nullopt, std::nullopt }).first;
+	}
+
+	return *it;
+}
+
+std::pair<const CircleMaskKey, CircleMaskCache::Entry>& CircleMaskCache::Reference(const CircleMaskKey& key)
+{
+	auto& item = Find(key);
+	Entry& entry = item.second;
+
+	if (entry.ref_count == 0 && entry.unused_it != unused_.end())
+	{
+		unused_.erase(entry.unused_it);
+		entry.unused_it = unused_.end();
+	}
+
+	++entry.ref_count;
+	return item;
+}
+
+void CircleMaskCache::Release(const CircleMaskKey& key)
+{
+	const auto it = entries_.find(Normalize(key));
+
+	if (it == entries_.end() || it->second.ref_count == 0)
+	{
+		return;
+	}
+
+	Entry& entry = it->second;
+
+	if (--entry.ref_count == 0)
+	{
+		entry.unused_it = unused_.insert(unused_.end(), it->first);
+		Evict(max_unused_);
+	}
+}
+
+const raster::CoverageMask& CircleMaskCache::GetCoverage(const CircleMaskKey& key)
+{
+	auto& [normalized, entry] = Find(Normalize(key));
+
+	if (!entry.coverage && entry.spans)
+	{
+		entry.coverage.emplace(raster::CoverageMask::FromSpans(*entry.spans));
+	}
+	else if (!entry.coverage)
+	{
+		entry.coverage.emplace(raster::CoverageMask::FromSpans(normalized.backend->spans(normalized.radius, normalized.filled)));
+	}
+
+	const raster::CoverageMask& coverage = *entry.coverage;
+
+	// The entry goes to the back of the LRU, and at least two entries are kept, so the other operand of a hit test
+	// is not evicted by this lookup.
+	if (entry.ref_count == 0)
+	{
+		if (entry.unused_it != unused_.end())
+		{
+			unused_.erase(entry.unused_it);
+		}
+
+		entry.unused_it = unused_.insert(unused_.end(), normalized);
+		Evict(std::max<std::size_t>(max_unused_, 2));
+	}
+
+	return coverage;
+}
+
+void CircleMaskCache::Trim()
+{
+	Evict(0);
+
+	for (auto& [capacity, textures] : spare_textures_)
+	{
+		for (SDL_Texture* texture : textures)
+		{
+			SDL_DestroyTexture(texture);
+		}
+	}
+
+	spare_textures_.clear();
+	spare_count_ = 0;
+}
+
+std::size_t CircleMaskCache::GetRasterizationCount() const
+{
+	return rasterizations_;
+}
+
+std::size_t CircleMaskCache::GetTextureCreationCount() const
+{
+	return texture_creations_;
+}
+
+int CircleMaskCache::GetTextureCapacity(int size)
+{
+	int step = 8;
+
+	while (step * 8 <= size)
+	{
+		step *= 2;
+	}
+
+	return (size + step - 1) / step * step;
+}
+
+SDL_Texture* CircleMaskCache::TakeTexture(int capacity)
+{
+	const auto it = spare_textures_.find(capacity);
+
+	if (it != spare_textures_.end() && !it->second.empty())
+	{
+		SDL_Texture* texture = it->second.back();
+		it->second.pop_back();
+		--spare_count_;
+		return texture;
+	}
+
+	SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, capacity, capacity);
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	++texture_creations_;
+	return texture;
+}
+
+void CircleMaskCache::Build(ThreadPool* pool)
+{
+	if (pending_.empty())
+	{
+		return;
+	}
+
+	std::vector<std::pair<const CircleMaskKey, Entry>*> jobs;
+	std::vector<raster::Surface> targets;
+	std::vector<raster::PixelBuffer> staging(pending_.size());
+	jobs.reserve(pending_.size());
+	targets.reserve(pending_.size());
+
+	// SDL and the pixel pool are both confined to this thread, so every texture is locked here and the workers
+	// only write into the memory they were handed.
+	for (const CircleMaskKey& key : pending_)
+	{
+		auto* job = &*entries_.find(key);
+		const int size = 2 * key.radius;
+		const SDL_Rect rect = { 0, 0, size, size };
+		void* pixels = nullptr;
+		int pitch = 0;
+
+		if (SDL_LockTexture(job->second.texture, &rect, &pixels, &pitch) == 0)
+		{
+			targets.push_back({ static_cast<std::uint32_t*>(pixels), size, size, pitch / static_cast<int>(sizeof(std::uint32_t)) });
+		}
+		else
+		{
+			raster::PixelBuffer& buffer = staging[jobs.size()];
+			buffer = pixel_pool_->Acquire(static_cast<std::size_t>(size) * size);
+			targets.push_back(buffer.GetSurface(size, size));
+		}
+
+		jobs.push_back(job);
+	}
+
+	const auto rasterize = [&jobs, &targets](std::size_t i)
+	{
+		Rasterize(jobs[i]->first, targets[i]);
+	};
+
+	if (pool != nullptr)
+	{
+		pool->ParallelFor(jobs.size(), rasterize);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < jobs.size(); ++i)
+		{
+			rasterize(i);
+		}
+	}
+
+	for (std::size_t i = 0; i < jobs.size(); ++i)
+	{
+		Entry& entry = jobs[i]->second;
+
+		if (staging[i].GetPixels() == nullptr)
+		{
+			SDL_UnlockTexture(entry.texture);
+		}
+		else
+		{
+			const int size = 2 * jobs[i]->first.radius;
+			const SDL_Rect rect = { 0, 0, size, size };
+			SDL_UpdateTexture(entry.texture, &rect, staging[i].GetPixels(), size * sizeof(std::uint32_t));
+			staging[i].Release();
+		}
+
+		entry.pending = false;
+	}
+
+	rasterizations_ += jobs.size();
+	pending_.clear();
+}
+
+void CircleMaskCache::Rasterize(const CircleMaskKey& key, const raster::Surface& surface)
+{
+	raster::Clear(surface, 0);
+	constexpr std::uint32_t white = raster::PackARGB(0xff, 0xff, 0xff);
+
+	key.backend->draw(surface, key.radius, key.filled, white);
+}
+
+void CircleMaskCache::Evict(std::size_t max_unused)
+{
+	while (unused_.size() > max_unused)
+	{
+		const auto it = entries_.find(unused_.front());
+
+		if (it->second.pending)
+		{
+			pending_.erase(std::find(pending_.begin(), pending_.end(), it->first));
+		}
+
+		if (it->second.texture != nullptr && spare_count_ < max_unused_)
+		{
+			spare_textures_[it->second.capacity].push_back(it->second.texture);
+			++spare_count_;
+		}
+		else if (it->second.texture != nullptr)
+		{
+			SDL_DestroyTexture(it->second.texture);
+		}
+
+		entries_.erase(it);
+		unused_.pop_front();
+	}
+}
@@ -0,0 +1,237 @@
+#include "FrameProfiler.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	FrameStats Summarize(std::vector<double> samples)
+	{
+		if (samples.empty())
+		{
+			return {};
+		}
+
+		std::sort(samples.begin(), samples.end());
+
+		const auto percentile = [&samples](double p)
+		{
+			const std::size_t rank = static_cast<std::size_t>(std::ceil(p * samples.size()));
+			return samples[std::min(samples.size(), std::max<std::size_t>(rank, 1)) - 1];
+		};
+
+		double sum = 0.0;
+
+		for (double sample : samples)
+		{
+			sum += sample;
+		}
+
+		return { percentile(0.50), percentile(0.95), percentile(0.99), samples.back(), sum / samples.size() };
+	}
+} // namespace
+
+FrameProfiler::FrameProfiler(std::size_t capacity) : 
+	frames_(std::max<std::size_t>(capacity, 1)), 
+	next_(0), 
+	size_(0), 
+	frame_count_(0), 
+	current_(), 
+	frame_start_(0), 
+	phase_start_(0), 
+	ms_per_count_(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()))
+{
+}
+
+void FrameProfiler::BeginFrame()
+{
+	current_ = {};
+	current_.index = frame_count_;
+	frame_start_ = SDL_GetPerformanceCounter();
+	phase_start_ = frame_start_;
+}
+
+void FrameProfiler::EndFrame()
+{
+	current_.total = SDL_GetPerformanceCounter() - frame_start_;
+	frames_[next_] = current_;
+	next_ = (next_ + 1) % frames_.size();
+	size_ = std::min(size_ + 1, frames_.size());
+	++frame_count_;
+}
+
+void FrameProfiler::BeginPhase()
+{
+	phase_start_ = SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::EndPhase(FramePhase phase)
+{
+	current_.phases[static_cast<std::size_t>(phase)] += SDL_GetPerformanceCounter() - phase_start_;
+}
+
+std::size_t FrameProfiler::GetFrameCount() const
+{
+	return size_;
+}
+
+FrameStats FrameProfiler::GetStats(FramePhase phase) const
+{
+	std::vector<double> samples;
+	samples.reserve(size_);
+
+	for (const Frame* frame : GetFrames())
+	{
+		samples.push_back(ToMs(frame->phases[static_cast<std::size_t>(phase)]));
+	}
+
+	return Summarize(samples);
+}
+
+FrameStats FrameProfiler::GetFrameStats() const
+{
+	std::vector<double> samples;
+	samples.reserve(size_);
+
+	for (const Frame* frame : GetFrames())
+	{
+		samples.push_back(ToMs(frame->total));
+	}
+
+	return Summarize(samples);
+}
+
+bool FrameProfiler::WriteCsv(const char* path) const
+{
+	std::FILE* file = std::fopen(path, "w");
+
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	std::fprintf(file, "frame");
+
+	for (std::size_t i = 0; i < phase_count; ++i)
+	{
+		std::fprintf(file, ",%s_ms", GetPhaseName(static_cast<FramePhase>(i)));
+	}
+
+	std::fprintf(file, ",total_ms\n");
+
+	for (const Frame* frame : GetFrames())
+	{
+		std::fprintf(file, "%llu", static_cast<unsigned long long>(frame->index));
+
+		for (std::size_t i = 0; i < phase_count; ++i)
+		{
+			std::fprintf(file, ",%.4f", ToMs(frame->phases[i]));
+		}
+
+		std::fprintf(file, ",%.4f\n", ToMs(frame->total));
+	}
+
+	return std::fclose(file) == 0;
+}
+
+bool FrameProfiler::WriteJson(const char* path) const
+{
+	std::FILE* file = std::fopen(path, "w");
+
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	const auto write_stats = [file](const char* name, const FrameStats& stats, bool last)
+	{
+		std::fprintf(file, "    \"%s\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"worst\": %.4f, \"mean\": %.4f}%s\n",
+			name, stats.p50, stats.p95, stats.p99, stats.worst, stats.mean, last ? "" : ",");
+	};
+
+	std::fprintf(file, "{\n  \"summary_ms\": {\n");
+
+	for (std::size_t i = 0; i < phase_count; ++i)
+	{
+		const FramePhase phase = static_cast<FramePhase>(i);
+		write_stats(GetPhaseName(phase), GetStats(phase), false);
+	}
+
+	write_stats("total", GetFrameStats(), true);
+	std::fprintf(file, "  },\n  \"frames\": [");
+
+	bool first = true;
+
+	for (const Frame* frame : GetFrames())
+	{
+		std::fprintf(file, "%s\n    {\"frame\": %llu", first ? "" : ",", static_cast<unsigned long long>(frame->index));
+
+		for (std::size_t i = 0; i < phase_count; ++i)
+		{
+			std::fprintf(file, ", \"%s_ms\": %.4f", GetPhaseName(static_cast<FramePhase>(i)), ToMs(frame->phases[i]));
+		}
+
+		std::fprintf(file, ", \"total_ms\": %.4f}", ToMs(frame->total));
+		first = false;
+	}
+
+	std::fprintf(file, "\n  ]\n}\n");
+	return std::fclose(file) == 0;
+}
+
+void FrameProfiler::PrintSummary() const
+{
+	printf("Frame times over the last %zu frames (ms): phase p50 p95 p99 worst\n", size_);
+
+	for (std::size_t i = 0; i < phase_count; ++i)
+	{
+		const FramePhase phase = static_cast<FramePhase>(i);
+		const FrameStats stats = GetStats(phase);
+		printf("  %-13s %8.3f %8.3f %8.3f %8.3f\n", GetPhaseName(phase), stats.p50, stats.p95, stats.p99, stats.worst);
+	}
+
+	const FrameStats stats = GetFrameStats();
+	printf("  %-13s %8.3f %8.3f %8.3f %8.3f\n", "total", stats.p50, stats.p95, stats.p99, stats.worst);
+}
+
+const char* FrameProfiler::GetPhaseName(FramePhase phase)
+{
+	switch (phase)
+	{
+		case FramePhase::handle_events:
+			return "handle_events";
+		case FramePhase::tick:
+			return "tick";
+		case FramePhase::render:
+			return "render";
+		case FramePhase::present:
+			return "present";
+		default:
+			return "unknown";
+	}
+}
+
+std::vector<const FrameProfiler::Frame*> FrameProfiler::GetFrames() const
+{
+	std::vector<const Frame*> frames;
+	frames.reserve(size_);
+	const std::size_t oldest = size_ < frames_.size() ? 0 : next_;
+
+	for (std::size_t i = 0; i < size_; ++i)
+	{
+		frames.push_back(&frames_[(oldest + i) % frames_.size()]);
+	}
+
+	return frames;
+}
+
+double FrameProfiler::ToMs(std::uint64_t counts) const
+{
+	return static_cast<double>(counts) * ms_per_count_;
+}
@@ -1,23 +1,96 @@
 #include "Game.hpp"
+#include "BatchRenderer.hpp"
+#include "Camera.hpp"
 #include "Constants.hpp"
 #include "Circle.hpp"
+#include "CircleMaskCache.hpp"
+#include "FrameProfiler.hpp"
+#include "GameOptions.hpp"
+#include "ThreadPool.hpp"
+#include "raster/Backend.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <iterator>
 #include <memory>
 #include <iostream>
+#include <random>
 #include <time.h>
-#include <stdlib.h>
 
-Game::Game() : 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	// Screen radii at which a circle switches level of detail: up to lod_point_radius it is a plain quad, from
+	// lod_span_radius on its spans are emitted directly, and in between it copies a cached mask of its screen radius.
+	constexpr int lod_point_radius = 2;
+	constexpr int lod_span_radius = 128;
+
+	// A stress run profiles every frame up to this many, about 3 MiB of samples; longer runs keep the most recent.
+	constexpr int max_profiled_frames = 1 << 16;
+
+	constexpr float camera_pan_step = 32.0f;
+	constexpr float camera_zoom_step = 1.25f;
+
+	double GetElapsedMs(std::uint64_t start)
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	// Peak resident set size of the process in bytes, or 0 where the platform does not report it.
+	std::size_t GetPeakMemory()
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		rusage usage = {};
+
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+		{
+			return 0;
+		}
+
+#if defined(__APPLE__)
+		return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+		return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+		return 0;
+#endif
+	}
+} // namespace
+
+Game::Game(const GameOptions& options) : 
+	options_(options), 
 	initialized_(false), 
 	running_(false), 
-	game_ticks_(0)
+	game_ticks_(0), 
+	animating_(options.animating), 
+	framebuffer_mode_(false), 
+	framebuffer_texture_(nullptr), 
+	camera_(constants::screen_width, constants::screen_height), 
+	frame_profiler_(std::clamp(options.frame_count, 1024, max_profiled_frames)), 
+	construction_ms_(0.0)
 {
 	initialized_ = Initialize();
+
+	const std::uint64_t start = SDL_GetPerformanceCounter();
 	InitializeCircles();
+	construction_ms_ = GetElapsedMs(start);
+
+	if (initialized_ && options_.framebuffer_mode)
+	{
+		SetFramebufferMode(true);
+	}
 }
 
 Game::~Game()
@@ -27,6 +100,13 @@ Game::~Game()
 
 bool Game::Initialize()
 {
+	const bool headless = !options_.video_driver.empty();
+
+	if (headless)
+	{
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, options_.video_driver.c_str());
+	}
+
 	if (SDL_Init(SDL_INIT_VIDEO) < 0)
 	{
 		printf("SDL could not be initialized! SDL Error: %s\n", SDL_GetError());
@@ -46,7 +126,8 @@ bool Game::Initialize()
 		return false;
 	}
 
-	renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
+	// Drivers without a display have no GPU context, but the software renderer draws into their window surface.
+	renderer_ = SDL_CreateRenderer(window_, -1, headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED);
 
 	if (renderer_ == nullptr)
 	{
@@ -54,6 +135,8 @@ bool Game::Initialize()
 		return false;
 	}
 
+	batch_renderer_ = std::make_unique<BatchRenderer>(renderer_);
+
 	constexpr int img_flags = IMG_INIT_PNG;
 
 	if (!(IMG_Init(img_flags) & img_flags))
@@ -65,8 +148,35 @@ bool Game::Initialize()
 	return true;
 }
 
+bool Game::IsInitialized() const
+{
+	return initialized_;
+}
+
 void Game::Finalize()
 {
+	// Circles hand their masks back to the cache, whose textures must go before the renderer.
+	circles_.clear();
+
+	if (mask_cache_)
+	{
+		printf("Mask cache: %zu rasterizations, %zu textures created\n", mask_cache_->GetRasterizationCount(), mask_cache_->GetTextureCreationCount());
+		mask_cache_.reset();
+	}
+
+	if (pixel_pool_)
+	{
+		const raster::PixelPoolStats& stats = pixel_pool_->GetStats();
+		printf("Pixel pool: %zu requests, %zu heap allocations, peak %zu bytes in use, peak %zu bytes reserved\n",
+			stats.requests, stats.heap_allocations, stats.peak_bytes_in_use, stats.peak_bytes_reserved);
+		pixel_pool_.reset();
+	}
+
+	SDL_DestroyTexture(framebuffer_texture_);
+	framebuffer_texture_ = nullptr;
+	batch_renderer_.reset();
+	thread_pool_.reset();
+
 	SDL_DestroyWindow(window_);
 	window_ = nullptr;
 	
@@ -95,7 +205,11 @@ void Game::Run()
 	int frames = 0;
 	int ticks = 0;
 
-	while (running_)
+	const bool stress = options_.frame_count > 0;
+	const std::uint64_t run_start = SDL_GetPerformanceCounter();
+	int total_frames = 0;
+
+	while (running_ && (!stress || total_frames < options_.frame_count))
 	{
 		const std::uint64_t now = SDL_GetPerformanceCounter();
 		const long double elapsed = static_cast<long double>(now - last_time) / static_cast<long double>(SDL_GetPerformanceFrequency());
@@ -103,18 +217,37 @@ void Game::Run()
 		last_time = now;
 		delta += elapsed;
 
+		frame_profiler_.BeginFrame();
+		frame_profiler_.BeginPhase();
 		HandleEvents();
+		frame_profiler_.EndPhase(FramePhase::handle_events);
+
+		// A stress run ticks exactly once per frame, so its work does not depend on the speed of the machine.
+		if (stress)
+		{
+			delta = ms;
+		}
 
 		while (delta >= ms)
 		{
+			frame_profiler_.BeginPhase();
 			Tick();
+			frame_profiler_.EndPhase(FramePhase::tick);
 			delta -= ms;
 			++ticks;
 		}
 
 		//printf("%Lf\n", delta / ms);
+		frame_profiler_.BeginPhase();
 		Render();
+		frame_profiler_.EndPhase(FramePhase::render);
+
+		frame_profiler_.BeginPhase();
+		SDL_RenderPresent(renderer_);
+		frame_profiler_.EndPhase(FramePhase::present);
+		frame_profiler_.EndFrame();
 		++frames;
+		++total_frames;
 
 		if (SDL_GetTicks() - timer > 1000.0)
 		{
@@ -124,6 +257,13 @@ void Game::Run()
 			ticks = 0;
 		}
 	}
+
+	if (stress)
+	{
+		PrintStressReport(total_frames, GetElapsedMs(run_start) / 1000.0);
+	}
+
+	DumpFrameProfile();
 }
 
 void Game::HandleEvents()
@@ -137,6 +277,74 @@ void Game::HandleEvents()
 			running_ = false;
 			return;
 		}
+		if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_f)
+		{
+			SetFramebufferMode(!framebuffer_mode_);
+		}
+		if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_a)
+		{
+			animating_ = !animating_;
+		}
+		if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_p)
+		{
+			DumpFrameProfile();
+		}
+		if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_b)
+		{
+			CycleBackend();
+		}
+		if (e.type == SDL_KEYDOWN)
+		{
+			HandleCameraKey(e.key.keysym.sym);
+		}
+	}
+}
+
+void Game::CycleBackend()
+{
+	const std::deque<raster::CircleBackend>& backends = raster::GetCircleBackends();
+	const auto it = std::find_if(backends.begin(), backends.end(), [this](const raster::CircleBackend& backend) { return &backend == options_.backend; });
+	options_.backend = it == backends.end() || std::next(it) == backends.end() ? &backends.front() : &*std::next(it);
+
+	// Masks of the new backend are acquired and built as the circles are next rendered.
+	for (auto& circle : circles_)
+	{
+		circle->SetBackend(*options_.backend);
+	}
+
+	printf("Backend: %s\n", options_.backend->name);
+}
+
+void Game::HandleCameraKey(SDL_Keycode key)
+{
+	const float center_x = constants::screen_width / 2.0f;
+	const float center_y = constants::screen_height / 2.0f;
+
+	switch (key)
+	{
+		case SDLK_LEFT:
+			camera_.Pan(-camera_pan_step, 0.0f);
+			break;
+		case SDLK_RIGHT:
+			camera_.Pan(camera_pan_step, 0.0f);
+			break;
+		case SDLK_UP:
+			camera_.Pan(0.0f, -camera_pan_step);
+			break;
+		case SDLK_DOWN:
+			camera_.Pan(0.0f, camera_pan_step);
+			break;
+		case SDLK_EQUALS:
+			camera_.ZoomAt(camera_zoom_step, center_x, center_y);
+			break;
+		case SDLK_MINUS:
+			camera_.ZoomAt(1.0f / camera_zoom_step, center_x, center_y);
+			break;
+		case SDLK_0:
+			camera_.Reset();
+			break;
+		default:
+			break;
 	}
 }
 
@@ -148,20 +356,126 @@ void Game::Tick()
 	{
 		circle->Tick();
 	}
+
+	if (!animating_)
+	{
+		return;
+	}
+
+	// Every circle pulses between radius 40 and 59 and cycles its red channel, out of phase with its neighbours.
+	// The radii share 20 masks per shape, and colour changes only retint.
+	for (std::size_t i = 0; i < circles_.size(); ++i)
+	{
+		const int phase = game_ticks_ / 3 + static_cast<int>(i);
+		const int step = phase % 38;
+		circles_[i]->SetRadius(40 + (step < 19 ? step : 38 - step));
+
+		SDL_Color color = circles_[i]->GetColor();
+		color.r = static_cast<Uint8>(phase * 4);
+		circles_[i]->SetColor(color);
+	}
 }
 
 void Game::Render()
 {
+	if (framebuffer_mode_)
+	{
+		RenderFramebuffer();
+		return;
+	}
+
 	SDL_RenderSetViewport(renderer_, NULL);
 	SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xff);
 	SDL_RenderClear(renderer_);
 
+	// Off-screen circles cost one rectangle test, so the frame scales with what is visible rather than with the scene.
+	const SDL_Rect viewport = camera_.GetViewport();
+
 	for (auto& circle : circles_)
 	{
-		circle->Render();
+		const SDL_Rect dst = circle->GetScreenRect(camera_);
+
+		if (!camera_.IsVisible(dst))
+		{
+			continue;
+		}
+
+		const int screen_radius = dst.w / 2;
+
+		// Point-sized circles let their masks go, so the cache can evict them, and span-sized ones swap theirs for
+		// the cached spans.
+		if (screen_radius <= lod_point_radius)
+		{
+			circle->ReleaseMask();
+			circle->RenderPoint(*batch_renderer_, dst);
+		}
+		else if (screen_radius >= lod_span_radius)
+		{
+			circle->RenderSpans(*batch_renderer_, dst, viewport);
+		}
+		else
+		{
+			circle->Render(*batch_renderer_, dst);
+		}
 	}
 
-	SDL_RenderPresent(renderer_);
+	// Masks acquired this frame are still empty; they are rasterized on the worker threads and uploaded here.
+	mask_cache_->Build(thread_pool_.get());
+	batch_renderer_->Flush();
+}
+
+void Game::RenderFramebuffer()
+{
+	void* pixels = nullptr;
+	int pitch = 0;
+
+	if (SDL_LockTexture(framebuffer_texture_, nullptr, &pixels, &pitch) != 0)
+	{
+		return;
+	}
+
+	// Locked memory starts out undefined, so it is cleared before the Wu circles blend over it.
+	const raster::Surface framebuffer = { static_cast<std::uint32_t*>(pixels), constants::screen_width, constants::screen_height, pitch / static_cast<int>(sizeof(std::uint32_t)) };
+	raster::Clear(framebuffer, raster::PackARGB(0x00, 0x00, 0x00));
+
+	for (auto& circle : circles_)
+	{
+		if (camera_.IsVisible(circle->GetScreenRect(camera_)))
+		{
+			circle->Draw(framebuffer, camera_);
+		}
+	}
+
+	SDL_UnlockTexture(framebuffer_texture_);
+	SDL_RenderSetViewport(renderer_, NULL);
+	SDL_RenderCopy(renderer_, framebuffer_texture_, nullptr, nullptr);
+}
+
+void Game::SetFramebufferMode(bool enabled)
+{
+	framebuffer_mode_ = enabled;
+
+	if (enabled)
+	{
+		if (framebuffer_texture_ == nullptr)
+		{
+			framebuffer_texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, constants::screen_width, constants::screen_height);
+		}
+
+		// Nothing is drawn through the masks any more, so memory drops to the framebuffer texture and the spans of
+		// the circles that need them.
+		for (auto& circle : circles_)
+		{
+			circle->ReleaseMask();
+		}
+
+		mask_cache_->Trim();
+	}
+	else
+	{
+		SDL_DestroyTexture(framebuffer_texture_);
+		framebuffer_texture_ = nullptr;
+	}
 }
 
 bool Game::InitializeCircles()
@@ -169,20 +483,89 @@ bool Game::InitializeCircles()
 	// const SDL_Point center = { constants::screen_width / 2, constants::screen_height / 2 };
 	// const SDL_Color color = { 0x00, 0xff, 0x00, 0xff };
 
-	std::srand(std::time(nullptr));
-	std::rand();
+	if (!initialized_)
+	{
+		return false;
+	}
 
-	const int radius = 50;
+	// The seed actually used is kept so that a stress report names it.
+	if (!options_.seed)
+	{
+		options_.seed = static_cast<std::uint32_t>(std::time(nullptr));
+	}
 
-	for (int i = 0; i < 100; ++i)
+	std::mt19937 rng(*options_.seed);
+	std::uniform_int_distribution<int> x_distribution(0, constants::screen_width - 1);
+	std::uniform_int_distribution<int> y_distribution(0, constants::screen_height - 1);
+	std::uniform_int_distribution<int> radius_distribution(options_.min_radius, options_.max_radius);
+	std::uniform_int_distribution<int> channel_distribution(0, 0xfe);
+	std::uniform_real_distribution<double> unit_distribution(0.0, 1.0);
+	const double log_min_radius = std::log(static_cast<double>(options_.min_radius));
+	const double log_max_radius = std::log(static_cast<double>(options_.max_radius) + 1.0);
+
+	thread_pool_ = std::make_unique<ThreadPool>();
+	pixel_pool_ = std::make_unique<raster::PixelPool>();
+	mask_cache_ = std::make_unique<CircleMaskCache>(renderer_, pixel_pool_.get());
+	circles_.reserve(options_.circle_count);
+
+	for (std::size_t i = 0; i < options_.circle_count; ++i)
 	{
-		const SDL_Point center = { std::rand() % constants::screen_width, std::rand() % constants::screen_height };
-		Uint8 r = static_cast<Uint8>(std::rand()) % 0xff;
-		Uint8 g = static_cast<Uint8>(std::rand()) % 0xff;
-		Uint8 b = static_cast<Uint8>(std::rand()) % 0xff;
+		const SDL_Point center = { x_distribution(rng), y_distribution(rng) };
+		int radius = radius_distribution(rng);
+
+		if (options_.radius_distribution == RadiusDistribution::log_uniform)
+		{
+			const double log_radius = log_min_radius + unit_distribution(rng) * (log_max_radius - log_min_radius);
+			radius = std::clamp(static_cast<int>(std::exp(log_radius)), options_.min_radius, options_.max_radius);
+		}
+
+		const Uint8 r = static_cast<Uint8>(channel_distribution(rng));
+		const Uint8 g = static_cast<Uint8>(channel_distribution(rng));
+		const Uint8 b = static_cast<Uint8>(channel_distribution(rng));
 		const SDL_Color color = { r, g, b, 0xff };
-		circles_.emplace_back(std::make_unique<Circle>(renderer_, center, radius, color));
+		const bool filled = unit_distribution(rng) < options_.filled_fraction;
+		circles_.emplace_back(std::make_unique<Circle>(mask_cache_.get(), center, radius, color, filled, *options_.backend));
+	}
+
+	// Masks depend on the radius on screen, so Render acquires them as circles fall into the mask level of detail.
+	// The ones the first frame needs are acquired here and built across the thread pool, so the first frame does
+	// not stall on them; the framebuffer mode draws without masks and skips this.
+	if (!options_.framebuffer_mode)
+	{
+		for (auto& circle : circles_)
+		{
+			const SDL_Rect dst = circle->GetScreenRect(camera_);
+			const int screen_radius = dst.w / 2;
+
+			if (camera_.IsVisible(dst) && screen_radius > lod_point_radius && screen_radius < lod_span_radius)
+			{
+				circle->AcquireMask(screen_radius);
+			}
+		}
+
+		mask_cache_->Build(thread_pool_.get());
 	}
 
 	return true;
 }
+
+void Game::PrintStressReport(int frames, double seconds) const
+{
+	const FrameStats stats = frame_profiler_.GetFrameStats();
+
+	printf("Stress run: %zu circles, radius %d-%d, backend %s, seed %u\n", circles_.size(), options_.min_radius, options_.max_radius, options_.backend->name, *options_.seed);
+	printf("  construction  %10.3f ms\n", construction_ms_);
+	printf("  frames        %10d in %.3f s, %.1f fps\n", frames, seconds, seconds > 0.0 ? frames / seconds : 0.0);
+	printf("  frame time    p50 %.3f  p95 %.3f  p99 %.3f  worst %.3f ms\n", stats.p50, stats.p95, stats.p99, stats.worst);
+	printf("  peak memory   %10.1f MiB\n", static_cast<double>(GetPeakMemory()) / (1024.0 * 1024.0));
+}
+
+void Game::DumpFrameProfile() const
+{
+	if (!frame_profiler_.WriteCsv("frame_profile.csv") || !frame_profiler_.WriteJson("frame_profile.json"))
+	{
+		printf("%s\n", "Warning: Frame profile could not be written!");
+	}
+
+	frame_profiler_.PrintSummary();
+}
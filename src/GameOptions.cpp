@@ -0,0 +1,146 @@
+#include "GameOptions.hpp"
+#include "raster/Backend.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	bool ParseDistribution(const char* name, RadiusDistribution& distribution)
+	{
+		if (std::strcmp(name, "uniform") == 0)
+		{
+			distribution = RadiusDistribution::uniform;
+		}
+		else if (std::strcmp(name, "log") == 0)
+		{
+			distribution = RadiusDistribution::log_uniform;
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	// Accepts N for a fixed radius or MIN:MAX for a range.
+	bool ParseRadius(const char* value, int& min_radius, int& max_radius)
+	{
+		char* end = nullptr;
+		min_radius = static_cast<int>(std::strtol(value, &end, 10));
+		max_radius = *end == ':' ? static_cast<int>(std::strtol(end + 1, &end, 10)) : min_radius;
+
+		return *end == '\0' && min_radius >= 1 && max_radius >= min_radius;
+	}
+
+	// Accepts a plain decimal number up to max. strtoull would take a sign or leading spaces and wrap negative
+	// numbers around, so the value has to start with a digit.
+	bool ParseUnsigned(const char* value, unsigned long long max, unsigned long long& result)
+	{
+		if (!std::isdigit(static_cast<unsigned char>(*value)))
+		{
+			return false;
+		}
+
+		char* end = nullptr;
+		errno = 0;
+		result = std::strtoull(value, &end, 10);
+
+		return *end == '\0' && errno != ERANGE && result <= max;
+	}
+} // namespace
+
+void PrintGameUsage(const char* program)
+{
+	std::printf("Usage: %s [--count N] [--radius N | --radius MIN:MAX] [--radius-distribution uniform|log] [--filled FRACTION] "
+		"[--backend NAME] [--seed N] [--frames N] [--animate] [--framebuffer] [--video-driver NAME | --headless]\n", program);
+	std::printf("Backends:");
+
+	for (const raster::CircleBackend& backend : raster::GetCircleBackends())
+	{
+		std::printf(" %s", backend.name);
+	}
+
+	std::printf("\n");
+}
+
+bool ParseGameOptions(int argc, char* argv[], GameOptions& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		bool valid = true;
+
+		if (std::strcmp(arg, "--count") == 0 && has_value)
+		{
+			unsigned long long count = 0;
+			valid = ParseUnsigned(argv[++i], std::numeric_limits<std::size_t>::max(), count);
+			options.circle_count = static_cast<std::size_t>(count);
+		}
+		else if (std::strcmp(arg, "--radius") == 0 && has_value)
+		{
+			valid = ParseRadius(argv[++i], options.min_radius, options.max_radius);
+		}
+		else if (std::strcmp(arg, "--radius-distribution") == 0 && has_value)
+		{
+			valid = ParseDistribution(argv[++i], options.radius_distribution);
+		}
+		else if (std::strcmp(arg, "--filled") == 0 && has_value)
+		{
+			options.filled_fraction = std::clamp(std::atof(argv[++i]), 0.0, 1.0);
+		}
+		else if (std::strcmp(arg, "--backend") == 0 && has_value)
+		{
+			options.backend = raster::FindCircleBackend(argv[++i]);
+			valid = options.backend != nullptr;
+		}
+		else if (std::strcmp(arg, "--seed") == 0 && has_value)
+		{
+			unsigned long long seed = 0;
+			valid = ParseUnsigned(argv[++i], std::numeric_limits<std::uint32_t>::max(), seed);
+			options.seed = static_cast<std::uint32_t>(seed);
+		}
+		else if (std::strcmp(arg, "--frames") == 0 && has_value)
+		{
+			unsigned long long frames = 0;
+			valid = ParseUnsigned(argv[++i], std::numeric_limits<int>::max(), frames);
+			options.frame_count = static_cast<int>(frames);
+		}
+		else if (std::strcmp(arg, "--animate") == 0)
+		{
+			options.animating = true;
+		}
+		else if (std::strcmp(arg, "--framebuffer") == 0)
+		{
+			options.framebuffer_mode = true;
+		}
+		else if (std::strcmp(arg, "--video-driver") == 0 && has_value)
+		{
+			options.video_driver = argv[++i];
+		}
+		else if (std::strcmp(arg, "--headless") == 0)
+		{
+			options.video_driver = "dummy";
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if (!valid)
+		{
+			PrintGameUsage(argv[0]);
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,111 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t thread_count) : 
+	busy_(0), 
+	stopping_(false)
+{
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	workers_.reserve(thread_count);
+
+	for (std::size_t i = 0; i < thread_count; ++i)
+	{
+		workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		const std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	task_ready_.notify_all();
+
+	for (std::thread& worker : workers_)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+	{
+		const std::lock_guard<std::mutex> lock(mutex_);
+		tasks_.push_back(std::move(task));
+	}
+
+	task_ready_.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	tasks_done_.wait(lock, [this]() { return tasks_.empty() && busy_ == 0; });
+}
+
+void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& fn)
+{
+	std::atomic<std::size_t> next(0);
+
+	const auto drain = [&next, count, &fn]()
+	{
+		for (std::size_t i = next++; i < count; i = next++)
+		{
+			fn(i);
+		}
+	};
+
+	const std::size_t helpers = std::min(workers_.size(), count > 0 ? count - 1 : 0);
+
+	for (std::size_t i = 0; i < helpers; ++i)
+	{
+		Submit(drain);
+	}
+
+	drain();
+	Wait();
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			task_ready_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+
+			if (stopping_ && tasks_.empty())
+			{
+				return;
+			}
+
+			task = std::move(tasks_.front());
+			tasks_.pop_front();
+			++busy_;
+		}
+
+		task();
+
+		{
+			const std::lock_guard<std::mutex> lock(mutex_);
+			--busy_;
+		}
+
+		tasks_done_.notify_all();
+	}
+}
@@ -1,14 +1,19 @@
 #include "Game.hpp"
+#include "GameOptions.hpp"
 
 #include <memory>
 
 int main(int argc, char* argv[])
 {
-	(void) argc;
-	(void) argv;
+	GameOptions options;
 
-	const std::unique_ptr<Game> game = std::make_unique<Game>();
+	if (!ParseGameOptions(argc, argv, options))
+	{
+		return 1;
+	}
+
+	const std::unique_ptr<Game> game = std::make_unique<Game>(options);
 	game->Run();
 
-	return 0;
+	return game->IsInitialized() ? 0 : 1;
 }
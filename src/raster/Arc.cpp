@@ -0,0 +1,196 @@
+#include "raster/Arc.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Pixel (px, py) of a circle's bounding box is tested by the direction from the centre, which sits on the corner
+// between the four middle pixels, to the pixel's centre. In half pixels, with y flipped to point up, that is
+// (2 * px + 1 - 2 * radius, 2 * radius - 2 * py - 1): odd integers, so a pixel never lies exactly on the centre.
+namespace raster
+{
+	namespace
+	{
+		// Boundary directions are scaled to 2^14, which keeps every cross product well inside 64 bits.
+		constexpr double direction_scale = 16384.0;
+
+		std::int64_t FloorDiv(std::int64_t numerator, std::int64_t denominator)
+		{
+			const std::int64_t quotient = numerator / denominator;
+			return (numerator % denominator != 0 && ((numerator < 0) != (denominator < 0))) ? quotient - 1 : quotient;
+		}
+
+		std::int64_t CeilDiv(std::int64_t numerator, std::int64_t denominator)
+		{
+			return -FloorDiv(-numerator, denominator);
+		}
+
+		struct Interval
+		{
+			std::int64_t begin;
+			std::int64_t end;
+		};
+
+		// Columns px of a row at which p * dx + q >= 0, with dx = 2 * px + 1 - 2 * radius.
+		Interval HalfPlaneColumns(std::int64_t p, std::int64_t q, int radius, Interval row)
+		{
+			const std::int64_t t = -q - p * (1 - 2 * static_cast<std::int64_t>(radius));
+
+			if (p > 0)
+			{
+				row.begin = std::max(row.begin, CeilDiv(t, 2 * p));
+			}
+			else if (p < 0)
+			{
+				row.end = std::min(row.end, FloorDiv(t, 2 * p) + 1);
+			}
+			else if (t > 0)
+			{
+				row.end = row.begin;
+			}
+
+			return row;
+		}
+	} // namespace
+
+	ArcRange MakeArcRange(double start_degrees, double sweep_degrees)
+	{
+		constexpr double radians_per_degree = 3.14159265358979323846 / 180.0;
+		const double end_degrees = start_degrees + sweep_degrees;
+
+		ArcRange range = {};
+		range.start_x = static_cast<int>(std::lround(std::cos(start_degrees * radians_per_degree) * direction_scale));
+		range.start_y = static_cast<int>(std::lround(std::sin(start_degrees * radians_per_degree) * direction_scale));
+		range.end_x = static_cast<int>(std::lround(std::cos(end_degrees * radians_per_degree) * direction_scale));
+		range.end_y = static_cast<int>(std::lround(std::sin(end_degrees * radians_per_degree) * direction_scale));
+		range.reflex = sweep_degrees > 180.0;
+		range.full = sweep_degrees >= 360.0;
+		range.empty = sweep_degrees <= 0.0;
+
+		return range;
+	}
+
+	bool IsInArc(const ArcRange& range, std::int64_t dx, std::int64_t dy)
+	{
+		if (range.full || range.empty)
+		{
+			return range.full;
+		}
+
+		const bool after_start = range.start_x * dy - range.start_y * dx >= 0;
+		const bool before_end = dx * range.end_y - dy * range.end_x >= 0;
+
+		// A reflex range is everything outside the convex wedge from end to start.
+		return range.reflex ? (after_start || before_end) : (after_start && before_end);
+	}
+
+	void DrawArc(const Surface& surface, int x, int y, int radius, const ArcRange& range, bool filled, std::uint32_t color)
+	{
+		if (radius <= 0 || range.empty || x >= surface.width || y >= surface.height || x + 2 * radius <= 0 || y + 2 * radius <= 0)
+		{
+			return;
+		}
+
+		if (!filled)
+		{
+			const auto plot = [&](int px, int py)
+			{
+				const int sx = x + px;
+				const int sy = y + py;
+
+				if (sx >= 0 && sy >= 0 && sx < surface.width && sy < surface.height &&
+					IsInArc(range, 2 * px + 1 - 2 * radius, 2 * radius - 2 * py - 1))
+				{
+					surface.At(sx, sy) = color;
+				}
+			};
+
+			const int r = radius;
+			int ox = 0;
+			int oy = r;
+			int d = 1 - r;
+
+			while (ox < oy)
+			{
+				if (d < 0)
+				{
+					d = d + 2 * ox + 3;
+					++ox;
+				}
+				else
+				{
+					d = d + 2 * (ox - oy) + 5;
+					++ox;
+					--oy;
+				}
+
+				plot(r - ox, r - oy);
+				plot(r - 1 + ox, r - oy);
+				plot(r - oy, r - ox);
+				plot(r - 1 + oy, r - ox);
+				plot(r - oy, r - 1 + ox);
+				plot(r - 1 + oy, r - 1 + ox);
+				plot(r - ox, r - 1 + oy);
+				plot(r - 1 + ox, r - 1 + oy);
+			}
+
+			return;
+		}
+
+		thread_local std::vector<int> half_widths;
+		half_widths.resize(radius);
+		BresenhamHalfWidths(radius, half_widths.data());
+
+		const int row_begin = std::max(0, -y);
+		const int row_end = std::min(2 * radius, surface.height - y);
+
+		for (int py = row_begin; py < row_end; ++py)
+		{
+			const int half = half_widths[py < radius ? radius - 1 - py : py - radius];
+			const Interval disc = { std::max(radius - half, -x), std::min(radius + half, surface.width - x) };
+			const std::int64_t dy = 2 * radius - 2 * py - 1;
+
+			// cross(start, v) >= 0 and cross(v, end) >= 0 are each linear in the column, so each keeps one ray of
+			// the row. A convex range needs both, a reflex one either, which can leave two spans.
+			Interval spans[2] = { disc, { 0, 0 } };
+
+			if (!range.full)
+			{
+				spans[0] = HalfPlaneColumns(-range.start_y, range.start_x * dy, radius, disc);
+				const Interval before_end = HalfPlaneColumns(range.end_y, -range.end_x * dy, radius, range.reflex ? disc : spans[0]);
+
+				if (!range.reflex)
+				{
+					spans[0] = before_end;
+				}
+				else if (spans[0].begin >= spans[0].end)
+				{
+					spans[0] = before_end;
+				}
+				else if (before_end.begin < before_end.end)
+				{
+					// Overlapping or touching rays become one span.
+					if (before_end.begin <= spans[0].end && spans[0].begin <= before_end.end)
+					{
+						spans[0] = { std::min(spans[0].begin, before_end.begin), std::max(spans[0].end, before_end.end) };
+					}
+					else
+					{
+						spans[1] = before_end;
+					}
+				}
+			}
+
+			for (int i = 0; i < 2; ++i)
+			{
+				if (spans[i].begin < spans[i].end)
+				{
+					FillSpan(surface, y + py, x + static_cast<int>(spans[i].begin), x + static_cast<int>(spans[i].end), color);
+				}
+			}
+		}
+	}
+} // namespace raster
@@ -0,0 +1,182 @@
+#include "raster/Backend.hpp"
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+namespace raster
+{
+	namespace
+	{
+		SpanList NaiveSpans(int radius, bool filled)
+		{
+			(void) filled;
+			return CircleSpansNaive(radius);
+		}
+
+		SpanList BresenhamFillSpans(int radius, bool filled)
+		{
+			(void) filled;
+			return CircleSpansBresenham(radius, true);
+		}
+
+		template <SimdLevel Level>
+		void DrawNaive(const Surface& surface, int radius, bool filled, std::uint32_t color)
+		{
+			(void) filled;
+			CircleNaive(surface, radius, color, Level);
+		}
+
+		std::deque<CircleBackend> MakeBuiltins()
+		{
+			std::deque<CircleBackend> backends;
+
+			backends.push_back({ "naive", [](const Surface& s, int r, bool, std::uint32_t c) { CircleNaive(s, r, c); }, NaiveSpans, false, false });
+
+			// Only levels the CPU runs, since CircleNaive quietly falls back from the others and a cross-check
+			// against them would compare the fallback.
+			const SimdLevel detected = DetectSimdLevel();
+			const CircleBackend levels[] = {
+				{ "naive_scalar", DrawNaive<SimdLevel::scalar>, NaiveSpans, false, false },
+				{ "naive_sse2", DrawNaive<SimdLevel::sse2>, NaiveSpans, false, false },
+				{ "naive_avx2", DrawNaive<SimdLevel::avx2>, NaiveSpans, false, false },
+				{ "naive_avx512", DrawNaive<SimdLevel::avx512>, NaiveSpans, false, false },
+			};
+
+			for (int i = 0; i <= static_cast<int>(detected); ++i)
+			{
+				backends.push_back(levels[i]);
+			}
+
+			backends.push_back({ "bresenham", CircleBresenham, CircleSpansBresenham, true, false });
+			backends.push_back({ "span_fill", [](const Surface& s, int r, bool, std::uint32_t c) { CircleSpanFill(s, r, c); }, BresenhamFillSpans, false, false });
+			backends.push_back({ "spans", [](const Surface& s, int r, bool filled, std::uint32_t c) { DrawSpans(s, 0, 0, CircleSpansBresenham(r, filled), c); }, CircleSpansBresenham, true, false });
+			backends.push_back({ "wu", CircleWu, CircleSpansWu, true, true });
+
+			return backends;
+		}
+
+		// Width of the border around the box in a cross-check: one AVX-512 store, so a kernel that writes a vector past
+		// the end of a row is caught. The canary has zero alpha so anti-aliased kernels overwrite it like a cleared pixel.
+		constexpr int canary_border = 16;
+		constexpr std::uint32_t canary = 0x00c0ffee;
+
+		std::deque<CircleBackend>& GetRegistry()
+		{
+			static std::deque<CircleBackend> backends = MakeBuiltins();
+			return backends;
+		}
+
+		// Time of one draw in nanoseconds, doubling the number of draws until they fill min_sample_ms.
+		double TimeDraw(const CircleBackend& backend, const Surface& surface, int radius, bool filled, std::uint32_t color, double min_sample_ms)
+		{
+			using Clock = std::chrono::steady_clock;
+
+			for (int iterations = 1; ; iterations *= 2)
+			{
+				const Clock::time_point start = Clock::now();
+
+				for (int i = 0; i < iterations; ++i)
+				{
+					backend.draw(surface, radius, filled, color);
+				}
+
+				const double elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+				if (elapsed_ns >= min_sample_ms * 1e6 || iterations >= (1 << 24))
+				{
+					return elapsed_ns / iterations;
+				}
+			}
+		}
+	} // namespace
+
+	const std::deque<CircleBackend>& GetCircleBackends()
+	{
+		return GetRegistry();
+	}
+
+	const CircleBackend* FindCircleBackend(std::string_view name)
+	{
+		for (const CircleBackend& backend : GetRegistry())
+		{
+			if (name == backend.name)
+			{
+				return &backend;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const CircleBackend& GetDefaultCircleBackend()
+	{
+		static const CircleBackend& backend = *FindCircleBackend("bresenham");
+		return backend;
+	}
+
+	bool RegisterCircleBackend(const CircleBackend& backend)
+	{
+		if (FindCircleBackend(backend.name) != nullptr)
+		{
+			return false;
+		}
+
+		GetRegistry().push_back(backend);
+		return true;
+	}
+
+	CrossCheckResult CrossCheck(const CircleBackend& a, const CircleBackend& b, int radius, bool filled, std::uint32_t color, double min_sample_ms)
+	{
+		const int size = 2 * radius;
+		const int padded = size + 2 * canary_border;
+		std::vector<std::uint32_t> pixels_a(static_cast<std::size_t>(padded) * padded, canary);
+		std::vector<std::uint32_t> pixels_b(pixels_a.size(), canary);
+		const Surface padded_a = { pixels_a.data(), padded, padded, padded };
+		const Surface padded_b = { pixels_b.data(), padded, padded, padded };
+		const Surface surface_a = padded_a.Sub(canary_border, canary_border, size, size);
+		const Surface surface_b = padded_b.Sub(canary_border, canary_border, size, size);
+
+		Clear(surface_a, 0);
+		Clear(surface_b, 0);
+		a.draw(surface_a, radius, filled, color);
+		b.draw(surface_b, radius, filled, color);
+
+		CrossCheckResult result = { 0, -1, -1, 0.0, 0.0 };
+
+		for (int y = 0; y < padded; ++y)
+		{
+			for (int x = 0; x < padded; ++x)
+			{
+				const std::uint32_t pixel_a = padded_a.At(x, y);
+				const std::uint32_t pixel_b = padded_b.At(x, y);
+				const bool inside = x >= canary_border && y >= canary_border && x < canary_border + size && y < canary_border + size;
+
+				if (inside ? pixel_a == pixel_b : pixel_a == canary && pixel_b == canary)
+				{
+					continue;
+				}
+
+				if (result.mismatches == 0)
+				{
+					result.first_x = x - canary_border;
+					result.first_y = y - canary_border;
+				}
+
+				++result.mismatches;
+			}
+		}
+
+		result.ns_a = TimeDraw(a, surface_a, radius, filled, color, min_sample_ms);
+		result.ns_b = TimeDraw(b, surface_b, radius, filled, color, min_sample_ms);
+
+		return result;
+	}
+} // namespace raster
@@ -0,0 +1,210 @@
+#include "raster/CoverageMask.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raster
+{
+	namespace
+	{
+		// The 64 bits of row starting at column offset, which may be negative; columns outside the row read as clear.
+		std::uint64_t LoadBits(const std::uint64_t* row, int words, int offset)
+		{
+			const int index = offset >= 0 ? offset / 64 : -((63 - offset) / 64);
+			const int shift = offset - 64 * index;
+			const std::uint64_t low = index >= 0 && index < words ? row[index] : 0;
+			const std::uint64_t high = index + 1 >= 0 && index + 1 < words ? row[index + 1] : 0;
+
+			return shift == 0 ? low : (low >> shift) | (high << (64 - shift));
+		}
+
+		// Calls visit with every ANDed word of the overlap of a and b until it returns false.
+		template <typename Visit>
+		void ForEachOverlapWord(const CoverageMask& a, int ax, int ay, const CoverageMask& b, int bx, int by, Visit visit)
+		{
+			const int x_begin = std::max(ax, bx);
+			const int x_end = std::min(ax + a.GetWidth(), bx + b.GetWidth());
+			const int y_begin = std::max(ay, by);
+			const int y_end = std::min(ay + a.GetHeight(), by + b.GetHeight());
+
+			if (x_begin >= x_end || y_begin >= y_end)
+			{
+				return;
+			}
+
+			// Walk a's words in place and pull the matching, generally unaligned, 64 bits out of b.
+			const int word_begin = (x_begin - ax) / 64;
+			const int word_end = (x_end - ax - 1) / 64 + 1;
+
+			for (int y = y_begin; y < y_end; ++y)
+			{
+				const std::uint64_t* a_row = a.Row(y - ay);
+				const std::uint64_t* b_row = b.Row(y - by);
+
+				for (int w = word_begin; w < word_end; ++w)
+				{
+					if (!visit(a_row[w] & LoadBits(b_row, b.GetWordsPerRow(), 64 * w + ax - bx)))
+					{
+						return;
+					}
+				}
+			}
+		}
+	} // namespace
+
+	CoverageMask::CoverageMask() : 
+		width_(0), 
+		height_(0), 
+		words_per_row_(0)
+	{
+	}
+
+	CoverageMask::CoverageMask(int width, int height) : 
+		width_(width), 
+		height_(height), 
+		words_per_row_((width + 63) / 64), 
+		words_(static_cast<std::size_t>(words_per_row_) * height, 0)
+	{
+	}
+
+	CoverageMask CoverageMask::FromSurface(const Surface& surface)
+	{
+		CoverageMask mask(surface.width, surface.height);
+
+		for (int y = 0; y < surface.height; ++y)
+		{
+			const std::uint32_t* pixels = surface.Row(y);
+			std::uint64_t* row = mask.words_.data() + static_cast<std::size_t>(y) * mask.words_per_row_;
+
+			for (int x = 0; x < surface.width; ++x)
+			{
+				row[x / 64] |= static_cast<std::uint64_t>(pixels[x] != 0) << (x % 64);
+			}
+		}
+
+		return mask;
+	}
+
+	CoverageMask CoverageMask::FromSpans(const SpanList& spans)
+	{
+		CoverageMask mask(spans.width, spans.height);
+
+		for (const Span& span : spans.spans)
+		{
+			if (span.coverage != 0)
+			{
+				mask.SetSpan(span.y, span.x_begin, span.x_end);
+			}
+		}
+
+		return mask;
+	}
+
+	void CoverageMask::SetSpan(int y, int x_begin, int x_end)
+	{
+		std::uint64_t* row = words_.data() + static_cast<std::size_t>(y) * words_per_row_;
+
+		while (x_begin < x_end)
+		{
+			const int bit = x_begin % 64;
+			const int count = std::min(64 - bit, x_end - x_begin);
+			const std::uint64_t bits = count == 64 ? ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1);
+			row[x_begin / 64] |= bits << bit;
+			x_begin += count;
+		}
+	}
+
+	bool CoverageMask::Test(int x, int y) const
+	{
+		return (Row(y)[x / 64] >> (x % 64)) & 1;
+	}
+
+	std::size_t CoverageMask::Count() const
+	{
+		std::size_t count = 0;
+
+		for (std::uint64_t word : words_)
+		{
+			count += __builtin_popcountll(word);
+		}
+
+		return count;
+	}
+
+	const std::uint64_t* CoverageMask::Row(int y) const
+	{
+		return words_.data() + static_cast<std::size_t>(y) * words_per_row_;
+	}
+
+	int CoverageMask::GetWidth() const
+	{
+		return width_;
+	}
+
+	int CoverageMask::GetHeight() const
+	{
+		return height_;
+	}
+
+	int CoverageMask::GetWordsPerRow() const
+	{
+		return words_per_row_;
+	}
+
+	CoverageMask CircleCoverage(int radius, bool filled)
+	{
+		const int size = 2 * radius;
+
+		if (filled)
+		{
+			CoverageMask mask(size, size);
+			std::vector<int> half_widths(radius);
+			BresenhamHalfWidths(radius, half_widths.data());
+
+			for (int i = 0; i < radius; ++i)
+			{
+				mask.SetSpan(radius - 1 - i, radius - half_widths[i], radius + half_widths[i]);
+				mask.SetSpan(radius + i, radius - half_widths[i], radius + half_widths[i]);
+			}
+
+			return mask;
+		}
+
+		std::vector<std::uint32_t> pixels(static_cast<std::size_t>(size) * size, 0);
+		const Surface surface = { pixels.data(), size, size, size };
+		CircleBresenham(surface, radius, false, 1);
+
+		return CoverageMask::FromSurface(surface);
+	}
+
+	bool Overlaps(const CoverageMask& a, int ax, int ay, const CoverageMask& b, int bx, int by)
+	{
+		bool overlaps = false;
+
+		ForEachOverlapWord(a, ax, ay, b, bx, by, [&overlaps](std::uint64_t word)
+		{
+			overlaps = word != 0;
+			return !overlaps;
+		});
+
+		return overlaps;
+	}
+
+	std::size_t CountOverlap(const CoverageMask& a, int ax, int ay, const CoverageMask& b, int bx, int by)
+	{
+		std::size_t count = 0;
+
+		ForEachOverlapWord(a, ax, ay, b, bx, by, [&count](std::uint64_t word)
+		{
+			count += __builtin_popcountll(word);
+			return true;
+		});
+
+		return count;
+	}
+} // namespace raster
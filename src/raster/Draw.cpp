@@ -0,0 +1,195 @@
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace raster
+{
+	namespace
+	{
+		struct Clip
+		{
+			int x_begin;
+			int y_begin;
+			int x_end;
+			int y_end;
+
+			bool IsEmpty() const
+			{
+				return x_begin >= x_end || y_begin >= y_end;
+			}
+		};
+
+		// Part of the size x size box at (x, y) that lies on the surface, in surface coordinates.
+		Clip ClipBox(const Surface& surface, int x, int y, int size)
+		{
+			return { std::max(x, 0), std::max(y, 0), std::min(x + size, surface.width), std::min(y + size, surface.height) };
+		}
+
+		bool IsInside(const Surface& surface, int x, int y, int size)
+		{
+			return x >= 0 && y >= 0 && x + size <= surface.width && y + size <= surface.height;
+		}
+
+		void FillClippedSpan(const Surface& surface, int y, int x_begin, int x_end, std::uint32_t color)
+		{
+			if (y < 0 || y >= surface.height)
+			{
+				return;
+			}
+
+			x_begin = std::max(x_begin, 0);
+			x_end = std::min(x_end, surface.width);
+
+			if (x_begin < x_end)
+			{
+				FillSpan(surface, y, x_begin, x_end, color);
+			}
+		}
+
+		std::uint32_t Over(std::uint32_t dst, std::uint32_t src)
+		{
+			const std::uint32_t alpha = src >> 24;
+
+			if (alpha == 0xff)
+			{
+				return src;
+			}
+
+			// Weights out of 256 so that two equal channels blend back to themselves.
+			const std::uint32_t weight = alpha + (alpha >> 7);
+			const std::uint32_t inverse = 256 - weight;
+			const std::uint32_t rb = (((src & 0x00ff00ff) * weight + (dst & 0x00ff00ff) * inverse) >> 8) & 0x00ff00ff;
+			const std::uint32_t g = (((src & 0x0000ff00) * weight + (dst & 0x0000ff00) * inverse) >> 8) & 0x0000ff00;
+			const std::uint32_t a = alpha + (((dst >> 24) * inverse) >> 8);
+
+			return (a << 24) | rb | g;
+		}
+
+		std::uint32_t ScaleAlpha(std::uint32_t color, std::uint8_t coverage)
+		{
+			return (color & 0x00ffffff) | ((((color >> 24) * coverage + 127) / 255) << 24);
+		}
+	} // namespace
+
+	void DrawCircleBresenham(const Surface& surface, int x, int y, int radius, bool filled, std::uint32_t color)
+	{
+		const int size = 2 * radius;
+
+		if (IsInside(surface, x, y, size))
+		{
+			const Surface box = surface.Sub(x, y, size, size);
+
+			if (filled)
+			{
+				CircleSpanFill(box, radius, color);
+			}
+			else
+			{
+				CircleBresenham(box, radius, false, color);
+			}
+
+			return;
+		}
+
+		if (radius <= 0 || ClipBox(surface, x, y, size).IsEmpty())
+		{
+			return;
+		}
+
+		if (filled)
+		{
+			thread_local std::vector<int> half_widths;
+			half_widths.resize(radius);
+			BresenhamHalfWidths(radius, half_widths.data());
+
+			for (int i = 0; i < radius; ++i)
+			{
+				const int x_begin = x + radius - half_widths[i];
+				const int x_end = x + radius + half_widths[i];
+				FillClippedSpan(surface, y + radius - 1 - i, x_begin, x_end, color);
+				FillClippedSpan(surface, y + radius + i, x_begin, x_end, color);
+			}
+
+			return;
+		}
+
+		const auto plot = [&surface, color](int px, int py)
+		{
+			if (px >= 0 && py >= 0 && px < surface.width && py < surface.height)
+			{
+				surface.At(px, py) = color;
+			}
+		};
+
+		const int cx = x + radius;
+		const int cy = y + radius;
+		int ox = 0;
+		int oy = radius;
+		int d = 1 - radius;
+
+		while (ox < oy)
+		{
+			if (d < 0)
+			{
+				d = d + 2 * ox + 3;
+				++ox;
+			}
+			else
+			{
+				d = d + 2 * (ox - oy) + 5;
+				++ox;
+				--oy;
+			}
+
+			plot(cx - ox, cy - oy);
+			plot(cx - 1 + ox, cy - oy);
+			plot(cx - oy, cy - ox);
+			plot(cx - 1 + oy, cy - ox);
+			plot(cx - oy, cy - 1 + ox);
+			plot(cx - 1 + oy, cy - 1 + ox);
+			plot(cx - ox, cy - 1 + oy);
+			plot(cx - 1 + ox, cy - 1 + oy);
+		}
+	}
+
+	void DrawSpans(const Surface& surface, int x, int y, const SpanList& spans, std::uint32_t color)
+	{
+		for (const Span& span : spans.spans)
+		{
+			FillClippedSpan(surface, y + span.y, x + span.x_begin, x + span.x_end, span.coverage == 0xff ? color : ScaleAlpha(color, span.coverage));
+		}
+	}
+
+	void TintSpans(const Surface& surface, int x, int y, const SpanList& spans, std::uint32_t color)
+	{
+		for (const Span& span : spans.spans)
+		{
+			const std::uint32_t pixel = span.coverage == 0xff ? color : ScaleAlpha(color, span.coverage);
+			const int sy = y + span.y;
+
+			if (pixel >> 24 == 0xff)
+			{
+				FillClippedSpan(surface, sy, x + span.x_begin, x + span.x_end, pixel);
+				continue;
+			}
+
+			if (sy < 0 || sy >= surface.height || pixel >> 24 == 0)
+			{
+				continue;
+			}
+
+			std::uint32_t* row = surface.Row(sy);
+			const int x_end = std::min(x + span.x_end, surface.width);
+
+			for (int sx = std::max(x + span.x_begin, 0); sx < x_end; ++sx)
+			{
+				row[sx] = Over(row[sx], pixel);
+			}
+		}
+	}
+} // namespace raster
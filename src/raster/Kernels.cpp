@@ -0,0 +1,406 @@
+#include "raster/Kernels.hpp"
+#include "raster/CircleTables.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace raster
+{
+	namespace
+	{
+		using FixedKernel = void (*)(const Surface& surface, std::uint32_t color);
+
+		template <std::size_t... I>
+		constexpr std::array<FixedKernel, sizeof...(I)> MakeFixedFills(std::index_sequence<I...>)
+		{
+			return { { &FillCircleFixed<static_cast<int>(I) + 1>... } };
+		}
+
+		template <std::size_t... I>
+		constexpr std::array<FixedKernel, sizeof...(I)> MakeFixedOutlines(std::index_sequence<I...>)
+		{
+			return { { &OutlineCircleFixed<static_cast<int>(I) + 1>... } };
+		}
+
+		// Indexed by radius - 1.
+		constexpr std::array<FixedKernel, max_fixed_radius> fixed_fills = MakeFixedFills(std::make_index_sequence<max_fixed_radius>());
+		constexpr std::array<FixedKernel, max_fixed_radius> fixed_outlines = MakeFixedOutlines(std::make_index_sequence<max_fixed_radius>());
+
+		// Height of the edge of a circle of the given doubled radius above the column centre x (in half pixels),
+		// as 8.8 fixed-point pixels. The square root is tracked incrementally in root and refined to 8 fractional
+		// bits by interpolating between root^2 and (root + 1)^2.
+		std::int64_t WuEdgeHeight(std::int64_t diameter, std::int64_t x, std::int64_t& root)
+		{
+			const std::int64_t remainder = diameter * diameter - x * x;
+
+			if (remainder <= 0)
+			{
+				root = 0;
+				return 0;
+			}
+
+			while (root * root > remainder)
+			{
+				--root;
+			}
+
+			// The remainder is at most 2 * root past root^2, so below radius 2^21 the interpolation fits a 32-bit
+			// division, which is several times cheaper than a 64-bit one.
+			const std::uint64_t numerator = static_cast<std::uint64_t>(remainder - root * root) << 8;
+			const std::uint64_t denominator = static_cast<std::uint64_t>(2 * root + 1);
+			const std::uint64_t fraction = numerator <= UINT32_MAX
+				? static_cast<std::uint32_t>(numerator) / static_cast<std::uint32_t>(denominator)
+				: numerator / denominator;
+
+			return (root * 256 + static_cast<std::int64_t>(fraction)) >> 1;
+		}
+
+		// Fraction of row covered by everything below height, in 1/256.
+		int WuRowCoverage(std::int64_t height, int row)
+		{
+			return static_cast<int>(std::clamp<std::int64_t>(height - 256 * row, 0, 256));
+		}
+
+		// Walks one octant of a Wu circle column by column, calling plot(column, row, coverage) with coverage out of
+		// 255 for every partially or fully covered pixel on the edge, and returns the edge row of every octant column
+		// in edge_rows.
+		template <typename Plot>
+		void WalkWuOctant(int radius, bool filled, std::vector<int>& edge_rows, Plot plot)
+		{
+			// Work in half-pixel units so the centre of column k is the odd integer 2k + 1. The outline is the ring
+			// between radius - 1 and radius, so both edges are walked together.
+			std::int64_t outer_root = 2 * radius;
+			std::int64_t inner_root = 2 * (radius - 1);
+			edge_rows.clear();
+
+			for (int k = 0; k < radius; ++k)
+			{
+				const std::int64_t x = 2 * k + 1;
+				const std::int64_t outer = WuEdgeHeight(2 * radius, x, outer_root);
+				const int edge_row = static_cast<int>(outer >> 8);
+
+				// Past the diagonal the mirrored octant takes over.
+				if (edge_row < k)
+				{
+					break;
+				}
+
+				const std::int64_t inner = filled ? 256 * static_cast<std::int64_t>(edge_row) : WuEdgeHeight(2 * (radius - 1), x, inner_root);
+				const int first_row = std::max(k, static_cast<int>(inner >> 8));
+				const int last_row = std::min(edge_row, radius - 1);
+
+				for (int row = first_row; row <= last_row; ++row)
+				{
+					const int coverage = WuRowCoverage(outer, row) - WuRowCoverage(inner, row);
+
+					if (coverage > 0)
+					{
+						plot(k, row, (coverage * 255 + 128) >> 8);
+					}
+				}
+
+				edge_rows.push_back(edge_row);
+			}
+		}
+
+		// Half-width of the fully covered span of every row of a filled Wu quadrant, from the octant's edge rows:
+		// below the diagonal they are the full rows of column m, mirrored; above it, every octant column whose edge
+		// lies beyond m.
+		template <typename Visit>
+		void ForEachWuSolidRow(int radius, const std::vector<int>& edge_rows, Visit visit)
+		{
+			const int octant_columns = static_cast<int>(edge_rows.size());
+			int columns_beyond = octant_columns;
+
+			for (int m = 0; m < radius; ++m)
+			{
+				while (columns_beyond > 0 && edge_rows[columns_beyond - 1] <= m)
+				{
+					--columns_beyond;
+				}
+
+				visit(m, std::max(m < octant_columns ? edge_rows[m] : 0, columns_beyond));
+			}
+		}
+	} // namespace
+
+	void Clear(const Surface& surface, std::uint32_t color)
+	{
+		for (int y = 0; y < surface.height; ++y)
+		{
+			std::fill_n(surface.Row(y), surface.width, color);
+		}
+	}
+
+	void FillSpan(const Surface& surface, int y, int x_begin, int x_end, std::uint32_t color)
+	{
+		std::fill(surface.Row(y) + x_begin, surface.Row(y) + x_end, color);
+	}
+
+	void BresenhamHalfWidths(int radius, int* half_widths)
+	{
+		WalkHalfWidths(radius, half_widths);
+	}
+
+	void CircleBresenham(const Surface& surface, int radius, bool filled, std::uint32_t color)
+	{
+		if (!filled && radius > 0 && radius <= max_fixed_radius)
+		{
+			fixed_outlines[radius - 1](surface, color);
+			return;
+		}
+
+		const int r = radius;
+
+		int x = 0;
+		int y = r;
+		int d = 1 - r;
+
+		while (x < y)
+		{
+			if (d < 0)
+			{
+				d = d + 2 * x + 3;
+				++x;
+			}
+			else
+			{
+				d = d + 2 * (x - y) + 5;
+				++x;
+				--y;
+			}
+
+			surface.At(r - x, r - y) = color;
+			surface.At(r - 1 + x, r - y) = color;
+			surface.At(r - y, r - x) = color;
+			surface.At(r - 1 + y, r - x) = color;
+			surface.At(r - y, r - 1 + x) = color;
+			surface.At(r - 1 + y, r - 1 + x) = color;
+			surface.At(r - x, r - 1 + y) = color;
+			surface.At(r - 1 + x, r - 1 + y) = color;
+
+			if (filled)
+			{
+				ChordEFLA(surface, r - x, r - y, r - 1 + x, r - y, color);
+				ChordEFLA(surface, r - y, r - x, r - 1 + y, r - x, color);
+				ChordEFLA(surface, r - y, r - 1 + x, r - 1 + y, r - 1 + x, color);
+				ChordEFLA(surface, r - x, r - 1 + y, r - 1 + x, r - 1 + y, color);
+			}
+		}
+	}
+
+	void CircleSpanFill(const Surface& surface, int radius, std::uint32_t color)
+	{
+		if (radius <= 0)
+		{
+			return;
+		}
+
+		if (radius <= max_fixed_radius)
+		{
+			fixed_fills[radius - 1](surface, color);
+			return;
+		}
+
+		thread_local std::vector<int> half_widths;
+		half_widths.resize(radius);
+		BresenhamHalfWidths(radius, half_widths.data());
+
+		for (int i = 0; i < radius; ++i)
+		{
+			const int half = half_widths[i];
+			FillSpan(surface, radius - 1 - i, radius - half, radius + half, color);
+			FillSpan(surface, radius + i, radius - half, radius + half, color);
+		}
+	}
+
+	void CircleRing(const Surface& surface, int outer_radius, int inner_radius, std::uint32_t color)
+	{
+		if (outer_radius <= 0)
+		{
+			return;
+		}
+
+		inner_radius = std::clamp(inner_radius, 0, outer_radius);
+
+		thread_local std::vector<int> outer_widths;
+		thread_local std::vector<int> inner_widths;
+		outer_widths.resize(outer_radius);
+		inner_widths.assign(outer_radius, 0);
+		BresenhamHalfWidths(outer_radius, outer_widths.data());
+		BresenhamHalfWidths(inner_radius, inner_widths.data());
+
+		// Both tables count rows outwards from the centre, so row pair i of the ring is outer row pair i minus
+		// inner row pair i, which is empty past the inner radius.
+		for (int i = 0; i < outer_radius; ++i)
+		{
+			const int outer = outer_widths[i];
+			const int inner = inner_widths[i];
+
+			for (const int y : { outer_radius - 1 - i, outer_radius + i })
+			{
+				if (inner == 0)
+				{
+					FillSpan(surface, y, outer_radius - outer, outer_radius + outer, color);
+				}
+				else
+				{
+					FillSpan(surface, y, outer_radius - outer, outer_radius - inner, color);
+					FillSpan(surface, y, outer_radius + inner, outer_radius + outer, color);
+				}
+			}
+		}
+	}
+
+	void CircleWu(const Surface& surface, int radius, bool filled, std::uint32_t color)
+	{
+		if (radius <= 0)
+		{
+			return;
+		}
+
+		const std::uint32_t rgb = color & 0x00ffffff;
+		const std::uint32_t alpha = color >> 24;
+
+		// Offsets are measured from the circle centre, which sits on the corner between the four middle pixels.
+		// Writes the four mirror images of (column, row), then the four of (row, column). The walk visits every
+		// octant pixel once and the two sets only coincide on the diagonal, so every pixel is stored exactly once.
+		const auto plot = [&](int column, int row, int coverage)
+		{
+			const std::uint32_t pixel = rgb | (((alpha * coverage + 127) / 255) << 24);
+
+			std::uint32_t* const above = surface.Row(radius - 1 - row);
+			std::uint32_t* const below = surface.Row(radius + row);
+			above[radius - 1 - column] = pixel;
+			above[radius + column] = pixel;
+			below[radius - 1 - column] = pixel;
+			below[radius + column] = pixel;
+
+			if (row != column)
+			{
+				std::uint32_t* const left_above = surface.Row(radius - 1 - column);
+				std::uint32_t* const left_below = surface.Row(radius + column);
+				left_above[radius - 1 - row] = pixel;
+				left_above[radius + row] = pixel;
+				left_below[radius - 1 - row] = pixel;
+				left_below[radius + row] = pixel;
+			}
+		};
+
+		thread_local std::vector<int> edge_rows;
+		WalkWuOctant(radius, filled, edge_rows, plot);
+
+		if (!filled)
+		{
+			return;
+		}
+
+		ForEachWuSolidRow(radius, edge_rows, [&](int m, int half)
+			{
+				FillSpan(surface, radius - 1 - m, radius - half, radius + half, color);
+				FillSpan(surface, radius + m, radius - half, radius + half, color);
+			});
+	}
+
+	void WuQuadrant(int radius, bool filled, std::vector<WuPixel>& edge, std::vector<int>& solid)
+	{
+		edge.clear();
+		solid.assign(std::max(radius, 0), 0);
+
+		if (radius <= 0)
+		{
+			return;
+		}
+
+		// Every octant pixel also stands for its reflection in the diagonal.
+		std::vector<int> edge_rows;
+		WalkWuOctant(radius, filled, edge_rows, [&edge](int column, int row, int coverage)
+			{
+				edge.push_back({ column, row, static_cast<std::uint8_t>(coverage) });
+
+				if (row != column)
+				{
+					edge.push_back({ row, column, static_cast<std::uint8_t>(coverage) });
+				}
+			});
+
+		if (filled)
+		{
+			ForEachWuSolidRow(radius, edge_rows, [&solid](int m, int half) { solid[m] = half; });
+		}
+
+		// Where the two octants meet a pixel is plotted twice and CircleWu keeps the higher coverage.
+		std::sort(edge.begin(), edge.end(), [](const WuPixel& lhs, const WuPixel& rhs)
+			{
+				return lhs.row != rhs.row ? lhs.row < rhs.row : lhs.column != rhs.column ? lhs.column < rhs.column : lhs.coverage > rhs.coverage;
+			});
+
+		const auto duplicate = [](const WuPixel& lhs, const WuPixel& rhs) { return lhs.row == rhs.row && lhs.column == rhs.column; };
+		edge.erase(std::unique(edge.begin(), edge.end(), duplicate), edge.end());
+		edge.erase(std::remove_if(edge.begin(), edge.end(), [&solid](const WuPixel& pixel) { return pixel.column < solid[pixel.row]; }), edge.end());
+	}
+
+	void ChordEFLA(const Surface& surface, int x1, int y1, int x2, int y2, std::uint32_t color)
+	{
+		bool y_longer = false;
+		int increment_val = 0;
+		int end_val = 0;
+		int short_len = y2 - y1;
+		int long_len = x2 - x1;
+
+		if (std::abs(short_len) > std::abs(long_len))
+		{
+			std::swap(short_len, long_len);
+			y_longer = true;
+		}
+
+		end_val = long_len;
+
+		if (long_len < 0)
+		{
+			increment_val = -1;
+			long_len = -long_len;
+		}
+		else
+		{
+			increment_val = 1;
+		}
+
+		double dec_inc = 0.0;
+
+		if (long_len == 0)
+		{
+			dec_inc = static_cast<double>(short_len);
+		}
+		else
+		{
+			dec_inc = (static_cast<double>(short_len) / static_cast<double>(long_len));
+		}
+
+		double j = 0.0;
+
+		if (y_longer)
+		{
+			for (int i = 0; i != end_val; i += increment_val)
+			{
+				surface.At(x1 + static_cast<int>(j), y1 + i) = color;
+				j += dec_inc;
+			}
+		}
+		else
+		{
+			for (int i = 0; i != end_val; i += increment_val)
+			{
+				surface.At(x1 + i, y1 + static_cast<int>(j)) = color;
+				j += dec_inc;
+			}
+		}
+	}
+} // namespace raster
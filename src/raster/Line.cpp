@@ -0,0 +1,204 @@
+#include "raster/Line.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+// Every segment is walked one step at a time along its major axis. Step i lands on major = major1 + i * sign and
+// minor = minor1 + floor((2 * i * minor_len + steps) / (2 * steps)), the true line rounded to the nearest pixel, so
+// the pixel at each step is known in closed form. Clipping therefore narrows the step range [first, last] against
+// the surface on both axes (Liang-Barsky in step space) instead of moving endpoints, and a clipped segment keeps its
+// exact pixels. The walk carries the fraction as an integer remainder, so it never drifts and always ends on the far
+// endpoint, however long the segment.
+namespace raster
+{
+	namespace
+	{
+		// Products of two coordinate differences need 65 bits, so the clipping arithmetic is done in 128.
+		__extension__ typedef __int128 Wide;
+
+		template <typename Int>
+		Int FloorDiv(Int numerator, Int denominator)
+		{
+			const Int quotient = numerator / denominator;
+			return (numerator % denominator != 0 && ((numerator < 0) != (denominator < 0))) ? quotient - 1 : quotient;
+		}
+
+		template <typename Int>
+		Int CeilDiv(Int numerator, Int denominator)
+		{
+			return -FloorDiv<Int>(-numerator, denominator);
+		}
+
+		// Narrows [first, last] to the steps where start + i * sign lies in [0, size).
+		void ClipMajor(std::int64_t start, int sign, int size, std::int64_t& first, std::int64_t& last)
+		{
+			if (sign > 0)
+			{
+				first = std::max(first, -start);
+				last = std::min(last, size - 1 - start);
+			}
+			else
+			{
+				first = std::max(first, start - (size - 1));
+				last = std::min(last, start);
+			}
+		}
+
+		// Narrows [first, last] to the steps whose minor coordinate lies in [0, size). That holds exactly when
+		// -(2 * start + 1) * steps <= 2 * i * len <= (2 * (size - start) - 1) * steps - 1. len is never 0 here.
+		void ClipMinor(std::int64_t start, std::int64_t len, std::int64_t steps, int size, std::int64_t& first, std::int64_t& last)
+		{
+			const Wide low = -(2 * Wide(start) + 1) * steps;
+			const Wide high = (2 * (Wide(size) - start) - 1) * steps - 1;
+			const Wide twice_len = 2 * Wide(len);
+			Wide lower = 0;
+			Wide upper = 0;
+
+			if (len > 0)
+			{
+				lower = CeilDiv(low, twice_len);
+				upper = FloorDiv(high, twice_len);
+			}
+			else
+			{
+				lower = CeilDiv(high, twice_len);
+				upper = FloorDiv(low, twice_len);
+			}
+
+			first = static_cast<std::int64_t>(std::max<Wide>(first, lower));
+			last = static_cast<std::int64_t>(std::min<Wide>(last, upper));
+		}
+
+		void DrawHorizontal(const Surface& surface, int x1, int x2, int y, std::uint32_t color)
+		{
+			if (y < 0 || y >= surface.height)
+			{
+				return;
+			}
+
+			const int x_begin = std::max(std::min(x1, x2), 0);
+			const int x_end = std::min(std::max(x1, x2) + 1, surface.width);
+
+			if (x_begin < x_end)
+			{
+				FillSpan(surface, y, x_begin, x_end, color);
+			}
+		}
+
+		void DrawVertical(const Surface& surface, int x, int y1, int y2, std::uint32_t color)
+		{
+			if (x < 0 || x >= surface.width)
+			{
+				return;
+			}
+
+			const int y_begin = std::max(std::min(y1, y2), 0);
+			const int y_end = std::min(std::max(y1, y2) + 1, surface.height);
+			std::uint32_t* pixel = surface.Row(y_begin) + x;
+
+			for (int y = y_begin; y < y_end; ++y, pixel += surface.stride)
+			{
+				*pixel = color;
+			}
+		}
+	} // namespace
+
+	void DrawLine(const Surface& surface, int x1, int y1, int x2, int y2, std::uint32_t color)
+	{
+		if (y1 == y2)
+		{
+			DrawHorizontal(surface, x1, x2, y1, color);
+			return;
+		}
+
+		if (x1 == x2)
+		{
+			DrawVertical(surface, x1, y1, y2, color);
+			return;
+		}
+
+		const std::int64_t dx = static_cast<std::int64_t>(x2) - x1;
+		const std::int64_t dy = static_cast<std::int64_t>(y2) - y1;
+		const bool y_major = std::llabs(dy) > std::llabs(dx);
+		const std::int64_t steps = y_major ? std::llabs(dy) : std::llabs(dx);
+		const int major_sign = (y_major ? dy : dx) > 0 ? 1 : -1;
+		const std::int64_t major_start = y_major ? y1 : x1;
+		const std::int64_t minor_start = y_major ? x1 : y1;
+		const std::int64_t minor_len = y_major ? dx : dy;
+
+		std::int64_t first = 0;
+		std::int64_t last = steps;
+		ClipMajor(major_start, major_sign, y_major ? surface.height : surface.width, first, last);
+		ClipMinor(minor_start, minor_len, steps, y_major ? surface.width : surface.height, first, last);
+
+		if (first > last)
+		{
+			return;
+		}
+
+		// minor + remainder / denominator is the exact minor coordinate plus one half at the current step.
+		const std::int64_t denominator = 2 * steps;
+		const Wide numerator = 2 * Wide(first) * minor_len + steps;
+		const Wide quotient = FloorDiv<Wide>(numerator, denominator);
+		const int major_first = static_cast<int>(major_start + first * major_sign);
+		int minor = static_cast<int>(minor_start + quotient);
+		std::int64_t remainder = static_cast<std::int64_t>(numerator - quotient * denominator);
+
+		// Per step the numerator grows by 2 * minor_len, which splits into a whole part and a remainder in
+		// [0, denominator).
+		const int minor_step = static_cast<int>(FloorDiv<std::int64_t>(2 * minor_len, denominator));
+		const std::int64_t remainder_step = 2 * minor_len - minor_step * denominator;
+
+		if (std::llabs(dx) == std::llabs(dy))
+		{
+			// 45 degrees: the minor axis moves exactly one pixel per step, so the pixel pointer advances by a constant.
+			const int x = y_major ? minor : major_first;
+			const int y = y_major ? major_first : minor;
+			const std::ptrdiff_t advance = static_cast<std::ptrdiff_t>(dy > 0 ? surface.stride : -surface.stride) + (dx > 0 ? 1 : -1);
+			std::uint32_t* pixel = surface.Row(y) + x;
+
+			for (std::int64_t i = first; i <= last; ++i, pixel += advance)
+			{
+				*pixel = color;
+			}
+		}
+		else if (y_major)
+		{
+			const std::ptrdiff_t advance = major_sign > 0 ? surface.stride : -surface.stride;
+			std::uint32_t* row = surface.Row(major_first);
+
+			for (std::int64_t i = first; i <= last; ++i, row += advance)
+			{
+				row[minor] = color;
+				minor += minor_step;
+				remainder += remainder_step;
+
+				if (remainder >= denominator)
+				{
+					remainder -= denominator;
+					++minor;
+				}
+			}
+		}
+		else
+		{
+			int x = major_first;
+
+			for (std::int64_t i = first; i <= last; ++i, x += major_sign)
+			{
+				surface.At(x, minor) = color;
+				minor += minor_step;
+				remainder += remainder_step;
+
+				if (remainder >= denominator)
+				{
+					remainder -= denominator;
+					++minor;
+				}
+			}
+		}
+	}
+} // namespace raster
@@ -0,0 +1,227 @@
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RASTER_X86 1
+#include <immintrin.h>
+#endif
+
+// Row-major inside test: pixel (x, y) is covered when (x - r)^2 <= r^2 - (y - r)^2. The squared column distance
+// is advanced with additions only, (dx + n)^2 = dx^2 + 2n * dx + n^2, with 2n * dx itself stepping by 2n^2, so
+// SSE2 needs no 32-bit multiply.
+namespace raster
+{
+	namespace
+	{
+		using NaiveFn = void (*)(const Surface& surface, int radius, std::uint32_t color);
+
+		void NaiveScalar(const Surface& surface, int radius, std::uint32_t color)
+		{
+			const int size = 2 * radius;
+
+			for (int y = 0; y < size; ++y)
+			{
+				std::uint32_t* row = surface.Row(y);
+				const int threshold = radius * radius - (y - radius) * (y - radius);
+
+				for (int x = 0; x < size; ++x)
+				{
+					if ((x - radius) * (x - radius) <= threshold)
+					{
+						row[x] = color;
+					}
+				}
+			}
+		}
+
+#ifdef RASTER_X86
+		__attribute__((target("sse2")))
+		void NaiveSse2(const Surface& surface, int radius, std::uint32_t color)
+		{
+			const int size = 2 * radius;
+			const int vector_end = size - size % 4;
+			const __m128i colors = _mm_set1_epi32(static_cast<int>(color));
+			const __m128i step_squared = _mm_set1_epi32(16);
+			const __m128i slope_step = _mm_set1_epi32(32);
+
+			for (int y = 0; y < size; ++y)
+			{
+				std::uint32_t* row = surface.Row(y);
+				const int threshold = radius * radius - (y - radius) * (y - radius);
+				const __m128i thresholds = _mm_set1_epi32(threshold);
+				__m128i slope = _mm_setr_epi32(-8 * radius, 8 * (1 - radius), 8 * (2 - radius), 8 * (3 - radius));
+				__m128i dx_squared = _mm_setr_epi32(radius * radius, (1 - radius) * (1 - radius), (2 - radius) * (2 - radius), (3 - radius) * (3 - radius));
+				int x = 0;
+
+				for (; x < vector_end; x += 4)
+				{
+					__m128i* dst = reinterpret_cast<__m128i*>(row + x);
+					const __m128i outside = _mm_cmpgt_epi32(dx_squared, thresholds);
+					const __m128i old = _mm_loadu_si128(dst);
+					_mm_storeu_si128(dst, _mm_or_si128(_mm_and_si128(outside, old), _mm_andnot_si128(outside, colors)));
+
+					dx_squared = _mm_add_epi32(dx_squared, _mm_add_epi32(slope, step_squared));
+					slope = _mm_add_epi32(slope, slope_step);
+				}
+
+				for (; x < size; ++x)
+				{
+					if ((x - radius) * (x - radius) <= threshold)
+					{
+						row[x] = color;
+					}
+				}
+			}
+		}
+
+		__attribute__((target("avx2")))
+		void NaiveAvx2(const Surface& surface, int radius, std::uint32_t color)
+		{
+			const int size = 2 * radius;
+			const int vector_end = size - size % 8;
+			const __m256i colors = _mm256_set1_epi32(static_cast<int>(color));
+			const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+			const __m256i step_squared = _mm256_set1_epi32(64);
+			const __m256i slope_step = _mm256_set1_epi32(128);
+
+			for (int y = 0; y < size; ++y)
+			{
+				std::uint32_t* row = surface.Row(y);
+				const int threshold = radius * radius - (y - radius) * (y - radius);
+				const __m256i limits = _mm256_set1_epi32(threshold + 1);
+				const __m256i dx = _mm256_add_epi32(_mm256_set1_epi32(-radius), lanes);
+				__m256i dx_squared = _mm256_mullo_epi32(dx, dx);
+				__m256i slope = _mm256_mullo_epi32(dx, _mm256_set1_epi32(16));
+				int x = 0;
+
+				for (; x < vector_end; x += 8)
+				{
+					const __m256i inside = _mm256_cmpgt_epi32(limits, dx_squared);
+					_mm256_maskstore_epi32(reinterpret_cast<int*>(row + x), inside, colors);
+
+					dx_squared = _mm256_add_epi32(dx_squared, _mm256_add_epi32(slope, step_squared));
+					slope = _mm256_add_epi32(slope, slope_step);
+				}
+
+				for (; x < size; ++x)
+				{
+					if ((x - radius) * (x - radius) <= threshold)
+					{
+						row[x] = color;
+					}
+				}
+			}
+		}
+
+		__attribute__((target("avx512f")))
+		void NaiveAvx512(const Surface& surface, int radius, std::uint32_t color)
+		{
+			const int size = 2 * radius;
+			const __m512i colors = _mm512_set1_epi32(static_cast<int>(color));
+			const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			const __m512i step_squared = _mm512_set1_epi32(256);
+			const __m512i slope_step = _mm512_set1_epi32(512);
+
+			for (int y = 0; y < size; ++y)
+			{
+				std::uint32_t* row = surface.Row(y);
+				const int threshold = radius * radius - (y - radius) * (y - radius);
+				const __m512i thresholds = _mm512_set1_epi32(threshold);
+				const __m512i dx = _mm512_add_epi32(_mm512_set1_epi32(-radius), lanes);
+				__m512i dx_squared = _mm512_mullo_epi32(dx, dx);
+				__m512i slope = _mm512_mullo_epi32(dx, _mm512_set1_epi32(32));
+
+				// The tail is handled by narrowing the store mask, so there is no scalar remainder loop.
+				for (int x = 0; x < size; x += 16)
+				{
+					const int remaining = size - x;
+					const __mmask16 lanes_left = remaining >= 16 ? static_cast<__mmask16>(0xffff) : static_cast<__mmask16>((1u << remaining) - 1);
+					const __mmask16 inside = _mm512_mask_cmple_epi32_mask(lanes_left, dx_squared, thresholds);
+					_mm512_mask_storeu_epi32(row + x, inside, colors);
+
+					dx_squared = _mm512_add_epi32(dx_squared, _mm512_add_epi32(slope, step_squared));
+					slope = _mm512_add_epi32(slope, slope_step);
+				}
+			}
+		}
+#endif
+
+		bool IsSupported(SimdLevel level)
+		{
+			return level <= DetectSimdLevel();
+		}
+
+		NaiveFn GetNaiveFn(SimdLevel level)
+		{
+			switch (level)
+			{
+#ifdef RASTER_X86
+				case SimdLevel::avx512:
+					return NaiveAvx512;
+				case SimdLevel::avx2:
+					return NaiveAvx2;
+				case SimdLevel::sse2:
+					return NaiveSse2;
+#endif
+				default:
+					return NaiveScalar;
+			}
+		}
+	} // namespace
+
+	SimdLevel DetectSimdLevel()
+	{
+		static const SimdLevel level = []()
+		{
+#ifdef RASTER_X86
+			__builtin_cpu_init();
+
+			if (__builtin_cpu_supports("avx512f"))
+			{
+				return SimdLevel::avx512;
+			}
+
+			if (__builtin_cpu_supports("avx2"))
+			{
+				return SimdLevel::avx2;
+			}
+
+			if (__builtin_cpu_supports("sse2"))
+			{
+				return SimdLevel::sse2;
+			}
+#endif
+			return SimdLevel::scalar;
+		}();
+
+		return level;
+	}
+
+	const char* SimdLevelName(SimdLevel level)
+	{
+		switch (level)
+		{
+			case SimdLevel::sse2:
+				return "sse2";
+			case SimdLevel::avx2:
+				return "avx2";
+			case SimdLevel::avx512:
+				return "avx512";
+			default:
+				return "scalar";
+		}
+	}
+
+	void CircleNaive(const Surface& surface, int radius, std::uint32_t color)
+	{
+		static const NaiveFn naive = GetNaiveFn(DetectSimdLevel());
+		naive(surface, radius, color);
+	}
+
+	void CircleNaive(const Surface& surface, int radius, std::uint32_t color, SimdLevel level)
+	{
+		GetNaiveFn(IsSupported(level) ? level : DetectSimdLevel())(surface, radius, color);
+	}
+} // namespace raster
@@ -0,0 +1,164 @@
+#include "raster/PixelPool.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace raster
+{
+	namespace
+	{
+		constexpr int min_class = 6;
+
+		int GetSizeClass(std::size_t pixels)
+		{
+			int size_class = min_class;
+
+			while (PixelPool::GetClassCapacity(size_class) < pixels)
+			{
+				++size_class;
+			}
+
+			return size_class;
+		}
+	} // namespace
+
+	PixelBuffer::PixelBuffer(PixelPool* pool, std::uint32_t* pixels, int size_class) : 
+		pool_(pool), 
+		pixels_(pixels), 
+		size_class_(size_class)
+	{
+	}
+
+	PixelBuffer::PixelBuffer() : 
+		pool_(nullptr), 
+		pixels_(nullptr), 
+		size_class_(0)
+	{
+	}
+
+	PixelBuffer::~PixelBuffer()
+	{
+		Release();
+	}
+
+	PixelBuffer::PixelBuffer(PixelBuffer&& other) noexcept : 
+		pool_(std::exchange(other.pool_, nullptr)), 
+		pixels_(std::exchange(other.pixels_, nullptr)), 
+		size_class_(std::exchange(other.size_class_, 0))
+	{
+	}
+
+	PixelBuffer& PixelBuffer::operator=(PixelBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			pool_ = std::exchange(other.pool_, nullptr);
+			pixels_ = std::exchange(other.pixels_, nullptr);
+			size_class_ = std::exchange(other.size_class_, 0);
+		}
+
+		return *this;
+	}
+
+	std::uint32_t* PixelBuffer::GetPixels() const
+	{
+		return pixels_;
+	}
+
+	std::size_t PixelBuffer::GetCapacity() const
+	{
+		return pixels_ != nullptr ? PixelPool::GetClassCapacity(size_class_) : 0;
+	}
+
+	Surface PixelBuffer::GetSurface(int width, int height) const
+	{
+		return { pixels_, width, height, width };
+	}
+
+	void PixelBuffer::Release()
+	{
+		if (pixels_ != nullptr)
+		{
+			pool_->Return(pixels_, size_class_);
+			pixels_ = nullptr;
+			pool_ = nullptr;
+		}
+	}
+
+	PixelPool::PixelPool() : 
+		stats_()
+	{
+	}
+
+	PixelPool::~PixelPool()
+	{
+		Trim();
+	}
+
+	PixelBuffer PixelPool::Acquire(std::size_t pixels)
+	{
+		const int size_class = GetSizeClass(pixels);
+		const std::size_t bytes = GetClassCapacity(size_class) * sizeof(std::uint32_t);
+
+		if (free_lists_.size() <= static_cast<std::size_t>(size_class))
+		{
+			free_lists_.resize(size_class + 1);
+		}
+
+		std::vector<std::uint32_t*>& free_list = free_lists_[size_class];
+		std::uint32_t* buffer = nullptr;
+
+		if (free_list.empty())
+		{
+			buffer = new std::uint32_t[GetClassCapacity(size_class)];
+			++stats_.heap_allocations;
+			stats_.bytes_reserved += bytes;
+			stats_.peak_bytes_reserved = std::max(stats_.peak_bytes_reserved, stats_.bytes_reserved);
+		}
+		else
+		{
+			buffer = free_list.back();
+			free_list.pop_back();
+		}
+
+		++stats_.requests;
+		stats_.bytes_in_use += bytes;
+		stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+
+		return PixelBuffer(this, buffer, size_class);
+	}
+
+	void PixelPool::Trim()
+	{
+		for (std::size_t size_class = 0; size_class < free_lists_.size(); ++size_class)
+		{
+			for (std::uint32_t* buffer : free_lists_[size_class])
+			{
+				delete[] buffer;
+				stats_.bytes_reserved -= GetClassCapacity(static_cast<int>(size_class)) * sizeof(std::uint32_t);
+			}
+
+			free_lists_[size_class].clear();
+		}
+	}
+
+	const PixelPoolStats& PixelPool::GetStats() const
+	{
+		return stats_;
+	}
+
+	std::size_t PixelPool::GetClassCapacity(int size_class)
+	{
+		return std::size_t(1) << size_class;
+	}
+
+	void PixelPool::Return(std::uint32_t* pixels, int size_class)
+	{
+		stats_.bytes_in_use -= GetClassCapacity(size_class) * sizeof(std::uint32_t);
+		free_lists_[size_class].push_back(pixels);
+	}
+} // namespace raster
@@ -0,0 +1,325 @@
+#include "raster/SpanList.hpp"
+#include "raster/Kernels.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace raster
+{
+	namespace
+	{
+		constexpr std::size_t header_size = 12;
+		constexpr std::size_t span_size = 7;
+
+		// Largest width or height whose spans fit the 16-bit fields.
+		constexpr int max_serialized_size = 0xffff;
+
+		void Write(std::vector<std::uint8_t>& data, std::uint32_t value, int bytes)
+		{
+			for (int i = 0; i < bytes; ++i)
+			{
+				data.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+			}
+		}
+
+		std::uint32_t Read(const std::uint8_t*& data, int bytes)
+		{
+			std::uint32_t value = 0;
+
+			for (int i = 0; i < bytes; ++i)
+			{
+				value |= static_cast<std::uint32_t>(*data++) << (8 * i);
+			}
+
+			return value;
+		}
+
+		// Sorts solid spans and merges the ones that overlap or touch.
+		void Normalize(std::vector<Span>& spans)
+		{
+			std::sort(spans.begin(), spans.end(), [](const Span& lhs, const Span& rhs)
+			{
+				return lhs.y != rhs.y ? lhs.y < rhs.y : lhs.x_begin < rhs.x_begin;
+			});
+
+			std::size_t merged = 0;
+
+			for (std::size_t i = 1; i < spans.size(); ++i)
+			{
+				Span& last = spans[merged];
+
+				if (spans[i].y == last.y && spans[i].x_begin <= last.x_end)
+				{
+					last.x_end = std::max(last.x_end, spans[i].x_end);
+				}
+				else
+				{
+					spans[++merged] = spans[i];
+				}
+			}
+
+			spans.resize(spans.empty() ? 0 : merged + 1);
+		}
+	} // namespace
+
+	SpanList CircleSpansNaive(int radius)
+	{
+		const int size = 2 * radius;
+		SpanList list = { size, size, {} };
+
+		// Row y covers |x - radius| <= root, with root the integer square root of radius^2 - (y - radius)^2. It
+		// only grows down to the middle row, so it is tracked incrementally.
+		int root = 0;
+
+		for (int y = 0; y < size; ++y)
+		{
+			const int threshold = radius * radius - (y - radius) * (y - radius);
+
+			if (y <= radius)
+			{
+				while ((root + 1) * (root + 1) <= threshold)
+				{
+					++root;
+				}
+			}
+			else
+			{
+				while (root * root > threshold)
+				{
+					--root;
+				}
+			}
+
+			list.spans.push_back({ y, radius - root, std::min(radius + root + 1, size), 0xff });
+		}
+
+		return list;
+	}
+
+	SpanList CircleSpansBresenham(int radius, bool filled)
+	{
+		const int size = 2 * radius;
+		SpanList list = { size, size, {} };
+
+		if (radius <= 0)
+		{
+			return list;
+		}
+
+		if (filled)
+		{
+			std::vector<int> half_widths(radius);
+			BresenhamHalfWidths(radius, half_widths.data());
+			list.spans.resize(size);
+
+			for (int i = 0; i < radius; ++i)
+			{
+				list.spans[radius - 1 - i] = { radius - 1 - i, radius - half_widths[i], radius + half_widths[i], 0xff };
+				list.spans[radius + i] = { radius + i, radius - half_widths[i], radius + half_widths[i], 0xff };
+			}
+
+			return list;
+		}
+
+		// Walk the octant of CircleBresenham and collect the top-left quadrant's pixels as runs: consecutive
+		// steps on the same row extend one run. The other three quadrants are mirror images.
+		std::vector<Span> quadrant;
+		int x = 0;
+		int y = radius;
+		int d = 1 - radius;
+
+		while (x < y)
+		{
+			if (d < 0)
+			{
+				d = d + 2 * x + 3;
+				++x;
+			}
+			else
+			{
+				d = d + 2 * (x - y) + 5;
+				++x;
+				--y;
+			}
+
+			if (!quadrant.empty() && quadrant.back().y == radius - y)
+			{
+				quadrant.back().x_begin = radius - x;
+			}
+			else
+			{
+				quadrant.push_back({ radius - y, radius - x, radius - x + 1, 0xff });
+			}
+
+			quadrant.push_back({ radius - x, radius - y, radius - y + 1, 0xff });
+		}
+
+		Normalize(quadrant);
+
+		for (const Span& span : quadrant)
+		{
+			const int mirrored_begin = size - span.x_end;
+			const int mirrored_end = size - span.x_begin;
+
+			for (const int row : { span.y, size - 1 - span.y })
+			{
+				// Runs reaching the middle column join their mirror image.
+				if (span.x_end >= mirrored_begin)
+				{
+					list.spans.push_back({ row, span.x_begin, mirrored_end, 0xff });
+				}
+				else
+				{
+					list.spans.push_back({ row, span.x_begin, span.x_end, 0xff });
+					list.spans.push_back({ row, mirrored_begin, mirrored_end, 0xff });
+				}
+			}
+		}
+
+		Normalize(list.spans);
+		return list;
+	}
+
+	SpanList CircleSpansWu(int radius, bool filled)
+	{
+		const int size = std::max(2 * radius, 0);
+		SpanList list = { size, size, {} };
+
+		std::vector<WuPixel> edge;
+		std::vector<int> solid;
+		WuQuadrant(radius, filled, edge, solid);
+
+		// Runs of equal coverage in one quadrant, with y the quadrant row and x measured from the centre column, and
+		// where the runs of each row start.
+		std::vector<Span> runs;
+		std::vector<std::size_t> row_starts(static_cast<std::size_t>(size / 2) + 1, 0);
+		auto pixel = edge.begin();
+
+		for (int m = 0; m < radius; ++m)
+		{
+			row_starts[m] = runs.size();
+
+			if (solid[m] > 0)
+			{
+				runs.push_back({ m, 0, solid[m], 0xff });
+			}
+
+			for (; pixel != edge.end() && pixel->row == m; ++pixel)
+			{
+				if (runs.size() > row_starts[m] && runs.back().x_end == pixel->column && runs.back().coverage == pixel->coverage)
+				{
+					++runs.back().x_end;
+				}
+				else
+				{
+					runs.push_back({ m, pixel->column, pixel->column + 1, pixel->coverage });
+				}
+			}
+		}
+
+		row_starts[size / 2] = runs.size();
+		list.spans.reserve(4 * runs.size());
+
+		// Every quadrant row appears once in each half, and every run once on each side of the centre; a run that
+		// starts at the centre joins its own reflection.
+		for (int y = 0; y < size; ++y)
+		{
+			const int m = y < radius ? radius - 1 - y : y - radius;
+			const Span* first = runs.data() + row_starts[m];
+			const Span* last = runs.data() + row_starts[m + 1];
+
+			for (const Span* run = last; run != first; --run)
+			{
+				const Span& mirrored = run[-1];
+				const int x_end = mirrored.x_begin == 0 ? radius + mirrored.x_end : radius - mirrored.x_begin;
+				list.spans.push_back({ y, radius - mirrored.x_end, x_end, mirrored.coverage });
+			}
+
+			for (const Span* run = first; run != last; ++run)
+			{
+				if (run->x_begin != 0)
+				{
+					list.spans.push_back({ y, radius + run->x_begin, radius + run->x_end, run->coverage });
+				}
+			}
+		}
+
+		return list;
+	}
+
+	bool SerializeSpans(const SpanList& spans, std::vector<std::uint8_t>& data)
+	{
+		if (spans.width < 0 || spans.height < 0 || spans.width > max_serialized_size || spans.height > max_serialized_size
+			|| spans.spans.size() > UINT32_MAX)
+		{
+			return false;
+		}
+
+		// The same bounds DeserializeSpans enforces, which also keep every field within 16 bits.
+		for (const Span& span : spans.spans)
+		{
+			if (span.y < 0 || span.y >= spans.height || span.x_begin < 0 || span.x_begin > span.x_end || span.x_end > spans.width)
+			{
+				return false;
+			}
+		}
+
+		data.clear();
+		data.reserve(header_size + span_size * spans.spans.size());
+
+		Write(data, static_cast<std::uint32_t>(spans.width), 4);
+		Write(data, static_cast<std::uint32_t>(spans.height), 4);
+		Write(data, static_cast<std::uint32_t>(spans.spans.size()), 4);
+
+		for (const Span& span : spans.spans)
+		{
+			Write(data, static_cast<std::uint32_t>(span.y), 2);
+			Write(data, static_cast<std::uint32_t>(span.x_begin), 2);
+			Write(data, static_cast<std::uint32_t>(span.x_end), 2);
+			Write(data, span.coverage, 1);
+		}
+
+		return true;
+	}
+
+	bool DeserializeSpans(const std::uint8_t* data, std::size_t size, SpanList& spans)
+	{
+		if (size < header_size)
+		{
+			return false;
+		}
+
+		const std::uint8_t* cursor = data;
+		const int width = static_cast<int>(Read(cursor, 4));
+		const int height = static_cast<int>(Read(cursor, 4));
+		const std::size_t count = Read(cursor, 4);
+
+		if (width < 0 || height < 0 || (size - header_size) / span_size < count)
+		{
+			return false;
+		}
+
+		std::vector<Span> decoded(count);
+
+		for (Span& span : decoded)
+		{
+			span.y = static_cast<int>(Read(cursor, 2));
+			span.x_begin = static_cast<int>(Read(cursor, 2));
+			span.x_end = static_cast<int>(Read(cursor, 2));
+			span.coverage = static_cast<std::uint8_t>(Read(cursor, 1));
+
+			if (span.y >= height || span.x_begin > span.x_end || span.x_end > width)
+			{
+				return false;
+			}
+		}
+
+		spans.width = width;
+		spans.height = height;
+		spans.spans.swap(decoded);
+		return true;
+	}
+} // namespace raster
@@ -0,0 +1,61 @@
+#ifndef CANVAS_HPP
+#define CANVAS_HPP
+
+#include "raster/Surface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Owns the pixels behind a surface, so tests can draw into scratch images of any size.
+class Canvas
+{
+private:
+	std::vector<std::uint32_t> pixels_;
+	raster::Surface surface_;
+
+public:
+	Canvas(int width, int height, std::uint32_t fill = 0) : 
+		pixels_(static_cast<std::size_t>(width) * height, fill), 
+		surface_({ pixels_.data(), width, height, width })
+	{
+	}
+
+	Canvas(const Canvas&) = delete;
+
+	Canvas& operator=(const Canvas&) = delete;
+
+	const raster::Surface& GetSurface() const
+	{
+		return surface_;
+	}
+
+	const std::vector<std::uint32_t>& GetPixels() const
+	{
+		return pixels_;
+	}
+
+	std::size_t CountNonZero() const
+	{
+		std::size_t count = 0;
+
+		for (const std::uint32_t pixel : pixels_)
+		{
+			count += pixel != 0;
+		}
+
+		return count;
+	}
+
+	bool operator==(const Canvas& other) const
+	{
+		return surface_.width == other.surface_.width && surface_.height == other.surface_.height && pixels_ == other.pixels_;
+	}
+
+	bool operator!=(const Canvas& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "Canvas.hpp"
+#include "Test.hpp"
+#include "raster/CoverageMask.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+
+namespace
+{
+	bool SameMask(const raster::CoverageMask& a, const raster::CoverageMask& b)
+	{
+		if (a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight())
+		{
+			return false;
+		}
+
+		for (int y = 0; y < a.GetHeight(); ++y)
+		{
+			for (int x = 0; x < a.GetWidth(); ++x)
+			{
+				if (a.Test(x, y) != b.Test(x, y))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Pixels covered by both masks, one pixel at a time.
+	std::size_t BruteForceOverlap(const raster::CoverageMask& a, int ax, int ay, const raster::CoverageMask& b, int bx, int by)
+	{
+		std::size_t count = 0;
+
+		for (int y = 0; y < a.GetHeight(); ++y)
+		{
+			for (int x = 0; x < a.GetWidth(); ++x)
+			{
+				const int x_in_b = ax + x - bx;
+				const int y_in_b = ay + y - by;
+
+				if (a.Test(x, y) && x_in_b >= 0 && y_in_b >= 0 && x_in_b < b.GetWidth() && y_in_b < b.GetHeight() && b.Test(x_in_b, y_in_b))
+				{
+					++count;
+				}
+			}
+		}
+
+		return count;
+	}
+} // namespace
+
+TEST(CircleCoverageMatchesKernel)
+{
+	for (int radius = 1; radius <= 200; ++radius)
+	{
+		for (const bool filled : { false, true })
+		{
+			Canvas canvas(2 * radius, 2 * radius);
+			raster::CircleBresenham(canvas.GetSurface(), radius, filled, 0xffffffff);
+
+			const raster::CoverageMask expected = raster::CoverageMask::FromSurface(canvas.GetSurface());
+			const raster::CoverageMask mask = raster::CircleCoverage(radius, filled);
+			CHECK_AT(SameMask(mask, expected), radius);
+			CHECK_AT(SameMask(raster::CoverageMask::FromSpans(raster::CircleSpansBresenham(radius, filled)), expected), radius);
+			CHECK_AT(mask.Count() == canvas.CountNonZero(), radius);
+		}
+	}
+}
+
+TEST(OverlapMatchesBruteForce)
+{
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> radius_distribution(1, 70);
+	std::uniform_int_distribution<int> filled_distribution(0, 1);
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const int ra = radius_distribution(rng);
+		const int rb = radius_distribution(rng);
+		const raster::CoverageMask a = raster::CircleCoverage(ra, filled_distribution(rng) != 0);
+		const raster::CoverageMask b = raster::CircleCoverage(rb, filled_distribution(rng) != 0);
+
+		// Offsets from well apart to fully nested, so words are shifted by every amount.
+		std::uniform_int_distribution<int> offset(-2 * rb - 2, 2 * ra + 2);
+		const int ax = 100;
+		const int ay = -40;
+		const int bx = ax + offset(rng);
+		const int by = ay + offset(rng);
+
+		const std::size_t expected = BruteForceOverlap(a, ax, ay, b, bx, by);
+		CHECK_AT(raster::CountOverlap(a, ax, ay, b, bx, by) == expected, i);
+		CHECK_AT(raster::Overlaps(a, ax, ay, b, bx, by) == (expected != 0), i);
+	}
+}
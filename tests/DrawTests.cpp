@@ -0,0 +1,240 @@
+#include "Canvas.hpp"
+#include "Test.hpp"
+#include "raster/Arc.hpp"
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Line.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <random>
+
+namespace
+{
+	constexpr std::uint32_t color = 0xff123456;
+	constexpr int screen_width = 64;
+	constexpr int screen_height = 48;
+
+	// Whether window, the screen-sized part of a larger canvas, holds the same pixels as screen.
+	bool SameWindow(const raster::Surface& screen, const raster::Surface& window)
+	{
+		for (int y = 0; y < screen.height; ++y)
+		{
+			for (int x = 0; x < screen.width; ++x)
+			{
+				if (screen.At(x, y) != window.At(x, y))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	__extension__ typedef __int128 Wide;
+
+	// Exact pixel of step i of a DrawLine segment: the true line rounded to the nearest pixel on the minor axis.
+	std::int64_t ReferenceMinor(std::int64_t minor_start, std::int64_t minor_len, std::int64_t steps, std::int64_t i)
+	{
+		const Wide numerator = 2 * static_cast<Wide>(i) * minor_len + steps;
+		const Wide denominator = 2 * static_cast<Wide>(steps);
+		Wide quotient = numerator / denominator;
+
+		if (numerator % denominator != 0 && numerator < 0)
+		{
+			--quotient;
+		}
+
+		return minor_start + static_cast<std::int64_t>(quotient);
+	}
+
+	// Draws the segment onto a cleared surface of the given size and compares it with the exact line, one pixel per
+	// major-axis step over the part of the segment that crosses the surface.
+	bool MatchesExactLine(int width, int height, int x1, int y1, int x2, int y2)
+	{
+		Canvas actual(width, height);
+		Canvas expected(width, height);
+		raster::DrawLine(actual.GetSurface(), x1, y1, x2, y2, color);
+
+		const std::int64_t dx = static_cast<std::int64_t>(x2) - x1;
+		const std::int64_t dy = static_cast<std::int64_t>(y2) - y1;
+		const bool y_major = std::llabs(dy) > std::llabs(dx);
+		const std::int64_t steps = y_major ? std::llabs(dy) : std::llabs(dx);
+		const std::int64_t major_start = y_major ? y1 : x1;
+		const int major_sign = (y_major ? dy : dx) >= 0 ? 1 : -1;
+		const int major_size = y_major ? height : width;
+		const int minor_size = y_major ? width : height;
+
+		for (int major = 0; major < major_size; ++major)
+		{
+			const std::int64_t i = (major - major_start) * major_sign;
+
+			if (i < 0 || i > steps)
+			{
+				continue;
+			}
+
+			const std::int64_t minor = steps == 0 ? (y_major ? x1 : y1) : ReferenceMinor(y_major ? x1 : y1, y_major ? dx : dy, steps, i);
+
+			if (minor >= 0 && minor < minor_size)
+			{
+				expected.GetSurface().At(y_major ? static_cast<int>(minor) : major, y_major ? major : static_cast<int>(minor)) = color;
+			}
+		}
+
+		return actual == expected;
+	}
+} // namespace
+
+TEST(ClippedBresenhamMatchesUnclipped)
+{
+	std::mt19937 rng(1);
+
+	for (int radius = 1; radius <= 40; ++radius)
+	{
+		const int size = 2 * radius;
+		const int pad = size + 8;
+		std::uniform_int_distribution<int> x_distribution(-size - 4, screen_width + 4);
+		std::uniform_int_distribution<int> y_distribution(-size - 4, screen_height + 4);
+
+		for (int i = 0; i < 40; ++i)
+		{
+			const int x = x_distribution(rng);
+			const int y = y_distribution(rng);
+
+			for (const bool filled : { false, true })
+			{
+				Canvas screen(screen_width, screen_height);
+				Canvas large(screen_width + 2 * pad, screen_height + 2 * pad);
+				raster::DrawCircleBresenham(screen.GetSurface(), x, y, radius, filled, color);
+				raster::CircleBresenham(large.GetSurface().Sub(x + pad, y + pad, size, size), radius, filled, color);
+				CHECK_AT(SameWindow(screen.GetSurface(), large.GetSurface().Sub(pad, pad, screen_width, screen_height)), radius);
+			}
+		}
+	}
+}
+
+TEST(ClippedSpansMatchUnclipped)
+{
+	std::mt19937 rng(2);
+
+	for (int radius = 1; radius <= 40; ++radius)
+	{
+		const int size = 2 * radius;
+		const int pad = size + 8;
+		const raster::SpanList spans = raster::CircleSpansWu(radius, true);
+		std::uniform_int_distribution<int> x_distribution(-size - 4, screen_width + 4);
+		std::uniform_int_distribution<int> y_distribution(-size - 4, screen_height + 4);
+
+		for (int i = 0; i < 40; ++i)
+		{
+			const int x = x_distribution(rng);
+			const int y = y_distribution(rng);
+			Canvas screen(screen_width, screen_height);
+			Canvas large(screen_width + 2 * pad, screen_height + 2 * pad);
+			raster::DrawSpans(screen.GetSurface(), x, y, spans, color);
+			raster::DrawSpans(large.GetSurface(), x + pad, y + pad, spans, color);
+			CHECK_AT(SameWindow(screen.GetSurface(), large.GetSurface().Sub(pad, pad, screen_width, screen_height)), radius);
+		}
+	}
+}
+
+TEST(ArcMatchesPerPixelTest)
+{
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<double> start_distribution(-360.0, 360.0);
+	std::uniform_real_distribution<double> sweep_distribution(-10.0, 380.0);
+
+	for (int radius = 1; radius <= 60; ++radius)
+	{
+		const int size = 2 * radius;
+		const int pad = size + 8;
+		std::uniform_int_distribution<int> x_distribution(-size - 4, screen_width + 4);
+		std::uniform_int_distribution<int> y_distribution(-size - 4, screen_height + 4);
+
+		for (int i = 0; i < 20; ++i)
+		{
+			const raster::ArcRange range = raster::MakeArcRange(start_distribution(rng), sweep_distribution(rng));
+			const int x = x_distribution(rng);
+			const int y = y_distribution(rng);
+
+			for (const bool filled : { false, true })
+			{
+				// The full circle or disc, then every pixel whose centre lies outside the range erased.
+				Canvas circle(size, size);
+
+				if (filled)
+				{
+					raster::CircleSpanFill(circle.GetSurface(), radius, color);
+				}
+				else
+				{
+					raster::CircleBresenham(circle.GetSurface(), radius, false, color);
+				}
+
+				Canvas large(screen_width + 2 * pad, screen_height + 2 * pad);
+
+				for (int py = 0; py < size; ++py)
+				{
+					for (int px = 0; px < size; ++px)
+					{
+						if (circle.GetSurface().At(px, py) != 0 && raster::IsInArc(range, 2 * px + 1 - size, size - 2 * py - 1))
+						{
+							large.GetSurface().At(x + pad + px, y + pad + py) = color;
+						}
+					}
+				}
+
+				Canvas screen(screen_width, screen_height);
+				raster::DrawArc(screen.GetSurface(), x, y, radius, range, filled, color);
+				CHECK_AT(SameWindow(screen.GetSurface(), large.GetSurface().Sub(pad, pad, screen_width, screen_height)), radius);
+			}
+		}
+	}
+}
+
+TEST(LineMatchesExactLine)
+{
+	std::mt19937 rng(4);
+	std::uniform_int_distribution<int> coordinate(-80, 120);
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int x1 = coordinate(rng);
+		const int y1 = coordinate(rng);
+		const int x2 = coordinate(rng);
+		const int y2 = coordinate(rng);
+		CHECK_AT(MatchesExactLine(screen_width, screen_height, x1, y1, x2, y2), i);
+	}
+}
+
+// Long and mostly off-surface segments, where any drift of the minor coordinate over millions of steps shows up as
+// missing or misplaced pixels.
+TEST(LongLinesDoNotDrift)
+{
+	struct Segment
+	{
+		int x1;
+		int y1;
+		int x2;
+		int y2;
+	};
+
+	const Segment segments[] = {
+		{ -1000000, -499995, 1000000, 500003 },
+		{ 1000000, 500003, -1000000, -499995 },
+		{ -499995, -1000000, 500003, 1000000 },
+		{ -2147483647, -1073741800, 2147483647, 1073741830 },
+		{ 5, 5, 2147483647, 2147483000 },
+		{ -2147483647, 9, 9, 2 },
+	};
+
+	for (const Segment& segment : segments)
+	{
+		CHECK_AT(MatchesExactLine(10, 10, segment.x1, segment.y1, segment.x2, segment.y2), segment.x1);
+	}
+}
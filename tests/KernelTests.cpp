@@ -0,0 +1,270 @@
+#include "Canvas.hpp"
+#include "Test.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/Surface.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <utility>
+
+namespace
+{
+	constexpr std::uint32_t color = 0xff123456;
+
+	// The original double-precision EFLA chord, which the filled baseline draws four of per step.
+	void BaselineChord(const raster::Surface& surface, int x1, int y1, int x2, int y2)
+	{
+		bool y_longer = false;
+		int short_len = y2 - y1;
+		int long_len = x2 - x1;
+
+		if (std::abs(short_len) > std::abs(long_len))
+		{
+			std::swap(short_len, long_len);
+			y_longer = true;
+		}
+
+		const int end_val = long_len;
+		const int increment_val = long_len < 0 ? -1 : 1;
+		long_len = std::abs(long_len);
+
+		const double dec_inc = long_len == 0 ? static_cast<double>(short_len) : static_cast<double>(short_len) / long_len;
+		double j = 0.0;
+
+		for (int i = 0; i != end_val; i += increment_val)
+		{
+			if (y_longer)
+			{
+				surface.At(x1 + static_cast<int>(j), y1 + i) = color;
+			}
+			else
+			{
+				surface.At(x1 + i, y1 + static_cast<int>(j)) = color;
+			}
+
+			j += dec_inc;
+		}
+	}
+
+	// The demo's original walk, before the kernels moved into the library.
+	void BaselineBresenham(const raster::Surface& surface, int radius, bool filled)
+	{
+		const int r = radius;
+		int x = 0;
+		int y = r;
+		int d = 1 - r;
+
+		while (x < y)
+		{
+			if (d < 0)
+			{
+				d = d + 2 * x + 3;
+				++x;
+			}
+			else
+			{
+				d = d + 2 * (x - y) + 5;
+				++x;
+				--y;
+			}
+
+			surface.At(r - x, r - y) = color;
+			surface.At(r - 1 + x, r - y) = color;
+			surface.At(r - y, r - x) = color;
+			surface.At(r - 1 + y, r - x) = color;
+			surface.At(r - y, r - 1 + x) = color;
+			surface.At(r - 1 + y, r - 1 + x) = color;
+			surface.At(r - x, r - 1 + y) = color;
+			surface.At(r - 1 + x, r - 1 + y) = color;
+
+			if (filled)
+			{
+				BaselineChord(surface, r - x, r - y, r - 1 + x, r - y);
+				BaselineChord(surface, r - y, r - x, r - 1 + y, r - x);
+				BaselineChord(surface, r - y, r - 1 + x, r - 1 + y, r - 1 + x);
+				BaselineChord(surface, r - x, r - 1 + y, r - 1 + x, r - 1 + y);
+			}
+		}
+	}
+
+	// Every pixel whose offset from the box centre pixel lies within the radius, as the naive kernel has always drawn.
+	void ReferenceNaive(const raster::Surface& surface, int radius)
+	{
+		for (int y = 0; y < 2 * radius; ++y)
+		{
+			for (int x = 0; x < 2 * radius; ++x)
+			{
+				if ((x - radius) * (x - radius) + (y - radius) * (y - radius) <= radius * radius)
+				{
+					surface.At(x, y) = color;
+				}
+			}
+		}
+	}
+} // namespace
+
+TEST(NaiveMatchesReferenceAtEverySimdLevel)
+{
+	const raster::SimdLevel detected = raster::DetectSimdLevel();
+
+	for (int radius = 1; radius <= 200; ++radius)
+	{
+		const int size = 2 * radius;
+		Canvas expected(size, size);
+		ReferenceNaive(expected.GetSurface(), radius);
+
+		for (int level = 0; level <= static_cast<int>(detected); ++level)
+		{
+			Canvas actual(size, size);
+			raster::CircleNaive(actual.GetSurface(), radius, color, static_cast<raster::SimdLevel>(level));
+			CHECK_AT(actual == expected, radius);
+		}
+	}
+}
+
+TEST(BresenhamMatchesBaseline)
+{
+	for (int radius = 1; radius <= 300; ++radius)
+	{
+		for (const bool filled : { false, true })
+		{
+			const int size = 2 * radius;
+			Canvas expected(size, size);
+			Canvas actual(size, size);
+			BaselineBresenham(expected.GetSurface(), radius, filled);
+			raster::CircleBresenham(actual.GetSurface(), radius, filled, color);
+			CHECK_AT(actual == expected, radius);
+		}
+	}
+}
+
+TEST(SpanFillMatchesFilledBresenham)
+{
+	for (int radius = 1; radius <= 500; ++radius)
+	{
+		const int size = 2 * radius;
+		Canvas expected(size, size);
+		Canvas actual(size, size);
+		raster::CircleBresenham(expected.GetSurface(), radius, true, color);
+		raster::CircleSpanFill(actual.GetSurface(), radius, color);
+		CHECK_AT(actual == expected, radius);
+	}
+}
+
+TEST(RingIsOuterDiscMinusInnerDisc)
+{
+	for (int outer = 1; outer <= 120; ++outer)
+	{
+		for (int inner = 0; inner <= outer; inner += 1 + outer / 16)
+		{
+			const int size = 2 * outer;
+			Canvas expected(size, size);
+			Canvas actual(size, size);
+			raster::CircleSpanFill(expected.GetSurface(), outer, color);
+
+			// The inner disc is centred in the same box and erased from the outer one.
+			const int offset = outer - inner;
+			raster::CircleSpanFill(expected.GetSurface().Sub(offset, offset, 2 * inner, 2 * inner), inner, 0);
+
+			raster::CircleRing(actual.GetSurface(), outer, inner, color);
+			CHECK_AT(actual == expected, outer * 1000 + inner);
+		}
+	}
+}
+
+TEST(WuCoverageIsCloseToSupersampling)
+{
+	constexpr int samples = 16;
+
+	for (int radius = 1; radius <= 48; ++radius)
+	{
+		for (const bool filled : { false, true })
+		{
+			const int size = 2 * radius;
+			Canvas canvas(size, size);
+			raster::CircleWu(canvas.GetSurface(), radius, filled, color);
+
+			// Sample positions in 1/(2 * samples) of a pixel, so they and both ring edges are exact integers.
+			const long long outer = static_cast<long long>(2 * samples * radius) * (2 * samples * radius);
+			const long long inner = filled ? -1 : static_cast<long long>(2 * samples * (radius - 1)) * (2 * samples * (radius - 1));
+			double worst = 0.0;
+
+			for (int y = 0; y < size; ++y)
+			{
+				for (int x = 0; x < size; ++x)
+				{
+					int covered = 0;
+
+					for (int sy = 0; sy < samples; ++sy)
+					{
+						for (int sx = 0; sx < samples; ++sx)
+						{
+							const long long dx = 2 * samples * (x - radius) + 2 * sx + 1;
+							const long long dy = 2 * samples * (y - radius) + 2 * sy + 1;
+							const long long distance = dx * dx + dy * dy;
+							covered += distance <= outer && distance > inner;
+						}
+					}
+
+					const double alpha = (canvas.GetSurface().At(x, y) >> 24) / 255.0;
+					worst = std::max(worst, std::abs(alpha - covered / static_cast<double>(samples * samples)));
+				}
+			}
+
+			CHECK_AT(worst < 0.14, radius);
+		}
+	}
+}
+
+TEST(KernelsStayInsideTheirBox)
+{
+	constexpr int border = 16;
+	constexpr std::uint32_t canary = 0x00c0ffee;
+
+	for (int radius = 1; radius <= 100; ++radius)
+	{
+		const int size = 2 * radius;
+		const int padded = size + 2 * border;
+
+		for (int kernel = 0; kernel < 6; ++kernel)
+		{
+			Canvas canvas(padded, padded, canary);
+			const raster::Surface box = canvas.GetSurface().Sub(border, border, size, size);
+			raster::Clear(box, 0);
+
+			switch (kernel)
+			{
+				case 0:
+					raster::CircleNaive(box, radius, color);
+					break;
+				case 1:
+					raster::CircleBresenham(box, radius, false, color);
+					break;
+				case 2:
+					raster::CircleBresenham(box, radius, true, color);
+					break;
+				case 3:
+					raster::CircleSpanFill(box, radius, color);
+					break;
+				case 4:
+					raster::CircleWu(box, radius, false, color);
+					break;
+				default:
+					raster::CircleWu(box, radius, true, color);
+					break;
+			}
+
+			for (int y = 0; y < padded; ++y)
+			{
+				for (int x = 0; x < padded; ++x)
+				{
+					const bool inside = x >= border && y >= border && x < border + size && y < border + size;
+					CHECK_AT(inside || canvas.GetSurface().At(x, y) == canary, radius * 10 + kernel);
+				}
+			}
+		}
+	}
+}
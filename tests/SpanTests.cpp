@@ -0,0 +1,155 @@
+#include "Canvas.hpp"
+#include "Test.hpp"
+#include "raster/Draw.hpp"
+#include "raster/Kernels.hpp"
+#include "raster/SpanList.hpp"
+#include "raster/Surface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace
+{
+	constexpr std::uint32_t color = 0xc0123456;
+
+	// Sorted by row and then column, non-empty, inside the list's bounds, and never touching a span of equal coverage.
+	bool IsWellFormed(const raster::SpanList& list)
+	{
+		for (std::size_t i = 0; i < list.spans.size(); ++i)
+		{
+			const raster::Span& span = list.spans[i];
+
+			if (span.y < 0 || span.y >= list.height || span.x_begin < 0 || span.x_begin >= span.x_end || span.x_end > list.width)
+			{
+				return false;
+			}
+
+			if (i > 0)
+			{
+				const raster::Span& previous = list.spans[i - 1];
+
+				if (previous.y > span.y || (previous.y == span.y && (previous.x_end > span.x_begin || (previous.x_end == span.x_begin && previous.coverage == span.coverage))))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Whether the spans, drawn onto a cleared box, give exactly the pixels of kernel.
+	template <typename Kernel>
+	bool MatchesKernel(const raster::SpanList& list, int radius, Kernel kernel)
+	{
+		const int size = 2 * radius;
+		Canvas expected(size, size);
+		Canvas actual(size, size);
+		kernel(expected.GetSurface());
+		raster::DrawSpans(actual.GetSurface(), 0, 0, list, color);
+
+		return list.width == size && list.height == size && IsWellFormed(list) && actual == expected;
+	}
+
+	bool RoundTrips(const raster::SpanList& list)
+	{
+		std::vector<std::uint8_t> data;
+		raster::SpanList decoded = { 0, 0, {} };
+
+		if (!raster::SerializeSpans(list, data) || !raster::DeserializeSpans(data.data(), data.size(), decoded))
+		{
+			return false;
+		}
+
+		if (decoded.width != list.width || decoded.height != list.height || decoded.spans.size() != list.spans.size())
+		{
+			return false;
+		}
+
+		for (std::size_t i = 0; i < list.spans.size(); ++i)
+		{
+			const raster::Span& a = list.spans[i];
+			const raster::Span& b = decoded.spans[i];
+
+			if (a.y != b.y || a.x_begin != b.x_begin || a.x_end != b.x_end || a.coverage != b.coverage)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+} // namespace
+
+TEST(NaiveSpansMatchKernel)
+{
+	for (int radius = 1; radius <= 200; ++radius)
+	{
+		CHECK_AT(MatchesKernel(raster::CircleSpansNaive(radius), radius, [radius](const raster::Surface& s) { raster::CircleNaive(s, radius, color); }), radius);
+	}
+}
+
+TEST(BresenhamSpansMatchKernel)
+{
+	for (int radius = 1; radius <= 300; ++radius)
+	{
+		for (const bool filled : { false, true })
+		{
+			CHECK_AT(MatchesKernel(raster::CircleSpansBresenham(radius, filled), radius, [radius, filled](const raster::Surface& s) { raster::CircleBresenham(s, radius, filled, color); }), radius);
+		}
+	}
+}
+
+TEST(WuSpansMatchKernel)
+{
+	for (int radius = 1; radius <= 300; ++radius)
+	{
+		for (const bool filled : { false, true })
+		{
+			CHECK_AT(MatchesKernel(raster::CircleSpansWu(radius, filled), radius, [radius, filled](const raster::Surface& s) { raster::CircleWu(s, radius, filled, color); }), radius);
+		}
+	}
+}
+
+TEST(SpansRoundTripThroughSerialization)
+{
+	for (int radius = 1; radius <= 100; radius += 7)
+	{
+		CHECK_AT(RoundTrips(raster::CircleSpansBresenham(radius, false)), radius);
+		CHECK_AT(RoundTrips(raster::CircleSpansWu(radius, true)), radius);
+	}
+
+	CHECK(RoundTrips({ 0, 0, {} }));
+	CHECK(RoundTrips({ 65535, 65535, { { 65534, 0, 65535, 0xff } } }));
+}
+
+TEST(SerializationRejectsWhatItCannotEncode)
+{
+	std::vector<std::uint8_t> data = { 1, 2, 3 };
+	const std::vector<std::uint8_t> untouched = data;
+
+	CHECK(!raster::SerializeSpans({ 65536, 1, {} }, data));
+	CHECK(!raster::SerializeSpans({ 1, 65536, {} }, data));
+	CHECK(!raster::SerializeSpans({ -1, 1, {} }, data));
+	CHECK(!raster::SerializeSpans({ 70000, 10, { { 0, 0, 70000, 0xff } } }, data));
+	CHECK(!raster::SerializeSpans({ 10, 10, { { 10, 0, 1, 0xff } } }, data));
+	CHECK(!raster::SerializeSpans({ 10, 10, { { 0, -1, 3, 0xff } } }, data));
+	CHECK(!raster::SerializeSpans({ 10, 10, { { 0, 4, 3, 0xff } } }, data));
+	CHECK(!raster::SerializeSpans({ 10, 10, { { 0, 0, 11, 0xff } } }, data));
+	CHECK(data == untouched);
+}
+
+TEST(DeserializationRejectsTruncatedData)
+{
+	std::vector<std::uint8_t> data;
+	CHECK(raster::SerializeSpans(raster::CircleSpansBresenham(20, false), data));
+
+	for (std::size_t size = 0; size < data.size(); ++size)
+	{
+		raster::SpanList decoded = { 0, 0, {} };
+		CHECK_AT(!raster::DeserializeSpans(data.data(), size, decoded), size);
+		CHECK_AT(decoded.width == 0 && decoded.spans.empty(), size);
+	}
+}
@@ -0,0 +1,48 @@
+#ifndef TEST_HPP
+#define TEST_HPP
+
+#include <cstdio>
+
+// A minimal test runner for the SDL-free core. TEST defines a case that registers itself before main, CHECK fails
+// the current case and returns from the enclosing function, and CHECK_AT does the same while naming the parameter,
+// usually a radius, at which the check failed.
+namespace test
+{
+	using TestFunction = void (*)();
+
+	bool Register(const char* name, TestFunction function);
+
+	void Fail(const char* file, int line, const char* expression);
+
+	void Fail(const char* file, int line, const char* expression, long long at);
+
+	// Runs every registered case, prints one line per failure and a summary, and returns the number of failed cases.
+	int RunAll();
+} // namespace test
+
+#define TEST(name) \
+	static void name(); \
+	static const bool name##_registered = test::Register(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do \
+	{ \
+		if (!(expression)) \
+		{ \
+			test::Fail(__FILE__, __LINE__, #expression); \
+			return; \
+		} \
+	} while (false)
+
+#define CHECK_AT(expression, at) \
+	do \
+	{ \
+		if (!(expression)) \
+		{ \
+			test::Fail(__FILE__, __LINE__, #expression, static_cast<long long>(at)); \
+			return; \
+		} \
+	} while (false)
+
+#endif
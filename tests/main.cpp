@@ -0,0 +1,69 @@
+#include "Test.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace test
+{
+	namespace
+	{
+		struct Case
+		{
+			const char* name;
+			TestFunction function;
+		};
+
+		// Function-local so that registration from other translation units never runs before it exists.
+		std::vector<Case>& GetCases()
+		{
+			static std::vector<Case> cases;
+			return cases;
+		}
+
+		const char* current_case = nullptr;
+		int current_failures = 0;
+	} // namespace
+
+	bool Register(const char* name, TestFunction function)
+	{
+		GetCases().push_back({ name, function });
+		return true;
+	}
+
+	void Fail(const char* file, int line, const char* expression)
+	{
+		std::fprintf(stderr, "%s:%d: %s: CHECK(%s) failed\n", file, line, current_case, expression);
+		++current_failures;
+	}
+
+	void Fail(const char* file, int line, const char* expression, long long at)
+	{
+		std::fprintf(stderr, "%s:%d: %s: CHECK(%s) failed at %lld\n", file, line, current_case, expression, at);
+		++current_failures;
+	}
+
+	int RunAll()
+	{
+		int failed = 0;
+
+		for (const Case& test_case : GetCases())
+		{
+			current_case = test_case.name;
+			current_failures = 0;
+			test_case.function();
+
+			if (current_failures != 0)
+			{
+				++failed;
+			}
+		}
+
+		std::printf("%zu tests, %d failed\n", GetCases().size(), failed);
+		return failed;
+	}
+} // namespace test
+
+int main()
+{
+	return test::RunAll() == 0 ? 0 : 1;
+}